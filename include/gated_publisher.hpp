@@ -0,0 +1,177 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include "observer.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace culib::patterns::details {
+
+	/**
+	 * @dev
+	 * Observer that stands between Publisher and target Observer for one event,
+	 * so a subscription can get its own delivery policy, i.e. throttling or another thread.
+	 *
+	 **/
+	template<typename Event, typename Value>
+	class Gate : public Observer<Event, Value> {
+	public:
+		Gate(Observer<Event, Value>* target, Event const& event) : target_ {target}, event_ {event} {}
+
+		Observer<Event, Value>* target() const noexcept { return target_; }
+		Event const& event() const noexcept { return event_; }
+
+	protected:
+		Observer<Event, Value>* target_;
+		Event event_;
+	};
+
+
+	/**
+	 * @dev
+	 * Common part of Publishers that serve some subscriptions by gates: registry of gates
+	 * per target Observer; Attach, Detach and hasSubscription see through a gate to its target,
+	 * so an observer is booked for an event once, with a gate or without.
+	 * Publish path is untouched, so subscriptions with no gate cost nothing extra.
+	 * Derived class attaches by AttachGatedImpl with its own gate, and gets onGateDetached()
+	 * called when the gate is already out of registry, but is still alive,
+	 * either on Detach or on removeEvent of its event.
+	 *
+	 **/
+	template<typename Event, typename Value, typename Hash = std::hash<Event>, typename Equal = std::equal_to<Event>>
+	class GatedPublisher : public Publisher<Event, Value, Hash, Equal> {
+	public:
+
+		using PublisherBase = Publisher<Event, Value, Hash, Equal>;
+		using ObserverType = typename PublisherBase::ObserverType;
+		using GateType = Gate<Event, Value>;
+
+		GatedPublisher() = default;
+		GatedPublisher(GatedPublisher const&) = delete;
+		GatedPublisher& operator=(GatedPublisher const&) = delete;
+
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		void Attach(ObserverType *observer, int niceValue, Events const&... events) &
+		{
+			(AttachPlainImpl(observer, niceValue, events), ...);
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		void Attach(ObserverType *observer, int niceValue, Container const& events) &
+		{
+			for (auto const& event : events) {
+				AttachPlainImpl(observer, niceValue, event);
+			}
+		}
+
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		void Detach(ObserverType *observer, Events const&... events) &
+		{
+			(DetachGatedImpl(observer, events), ...);
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		void Detach(ObserverType *observer, Container const& events) &
+		{
+			for (auto const& event : events) {
+				DetachGatedImpl(observer, event);
+			}
+		}
+
+		//gates of the event go first, each with onGateDetached(), so none is left behind for a re-added event
+		void removeEvent(Event const& event) & {
+			std::vector<ObserverType*> gated;
+			for (auto const& [observer, gates] : gates_) {
+				for (auto const& gate : gates) {
+					if (Equal{}(gate->event(), event)) {
+						gated.push_back(observer);
+						break;
+					}
+				}
+			}
+			for (ObserverType* observer : gated) {
+				DetachGatedImpl(observer, event);
+			}
+			PublisherBase::removeEvent(event);
+		}
+
+		bool hasSubscription(ObserverType *observer, Event const& event) const & noexcept {
+			if (GateType const* gate {findGate(observer, event)}; gate != nullptr) {
+				return PublisherBase::hasSubscription(const_cast<GateType*>(gate), event);
+			}
+			return PublisherBase::hasSubscription(observer, event);
+		}
+
+	protected:
+		std::unordered_map<ObserverType*, std::vector<std::unique_ptr<GateType>>> gates_;
+
+		virtual void onGateDetached([[maybe_unused]] GateType& gate) {}
+
+		GateType const* findGate(ObserverType *observer, Event const& event) const noexcept {
+			auto foundObserver = gates_.find(observer);
+			if (foundObserver == gates_.end()) {
+				return nullptr;
+			}
+			for (auto const& gate : foundObserver->second) {
+				if (Equal{}(gate->event(), event)) {
+					return gate.get();
+				}
+			}
+			return nullptr;
+		}
+
+		void AttachPlainImpl(ObserverType *observer, int niceValue, Event const& event) {
+			if (hasSubscription(observer, event)) {
+				//todo must be logged, observer already booked for event, maybe through a gate
+				return;
+			}
+			PublisherBase::AttachImpl(observer, niceValue, event);
+		}
+
+		//makeGate: std::unique_ptr<Gate>(), called only if the subscription is going to be made
+		template<typename MakeGate>
+		void AttachGatedImpl(ObserverType *observer, int niceValue, Event const& event, MakeGate&& makeGate) {
+			if (!this->eventExists(event) || hasSubscription(observer, event)) {
+				//todo must be logged, no event or observer already booked for event
+				return;
+			}
+			std::unique_ptr<GateType> gate {makeGate()};
+			PublisherBase::Attach(gate.get(), niceValue, event);
+			observer->bookEvent(event);
+			gates_[observer].push_back(std::move(gate));
+		}
+
+		void DetachGatedImpl(ObserverType *observer, Event const& event) {
+			auto foundObserver = gates_.find(observer);
+			if (foundObserver != gates_.end()) {
+				auto& gates {foundObserver->second};
+				auto found {std::find_if(gates.begin(), gates.end(), [&event](auto const& gate) {
+					return Equal{}(gate->event(), event);
+				})};
+				if (found != gates.end()) {
+					PublisherBase::Detach(found->get(), event);
+					onGateDetached(**found);
+					observer->removeEvent(event);
+					std::iter_swap(found, std::prev(gates.end()));
+					gates.pop_back();
+					if (gates.empty()) {
+						gates_.erase(foundObserver);
+					}
+					return;
+				}
+			}
+			PublisherBase::Detach(observer, event);
+		}
+	};
+
+}//!namespace
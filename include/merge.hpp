@@ -0,0 +1,265 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include "observer.hpp"
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace culib::patterns {
+
+	/**
+	 * @dev
+	 * Fan-in of several Publishers into one Observer in global order of a key,
+	 * i.e. exchange timestamp or sequence, extracted by KeyOf(event, value).
+	 * Each Publisher is attached to its own source, that is a single producer single consumer
+	 * queue, so publishers don't contend with each other and there is no global lock.
+	 * Every source stream is expected to be ordered by key on its own.
+	 * Consumer thread calls drain(), that does a k-way merge of the queue heads and hands
+	 * released items to the target Observer in a batch. Head is released, when every other
+	 * source has either got past its key, or is behind the newest key by more than window,
+	 * so an idle source doesn't stall the others. An item that arrives after a newer key was
+	 * released, is delivered as is and counted as late.
+	 * Consumer keeps its own copy of the watermarks and only looks at the sources that are
+	 * out of the heap and behind the head, so a release is normally free of cross core loads.
+	 * If a source queue is full, its publisher spins until consumer drains it, that never ends
+	 * if publisher and consumer is the same thread; use FullQueue::Drop then, extra items are
+	 * dropped and counted, see dropped().
+	 *
+	 **/
+	template<typename Event, typename Value, typename KeyOf>
+	requires std::integral<std::invoke_result_t<KeyOf, Event const&, Value const&>>
+	class OrderedFanIn {
+	public:
+
+		using ObserverType = Observer<Event, Value>;
+		using key_type = std::invoke_result_t<KeyOf, Event const&, Value const&>;
+
+		enum class FullQueue {
+			Spin,
+			Drop,
+		};
+
+		OrderedFanIn(ObserverType* target, KeyOf keyOf, key_type window, std::size_t sources, std::size_t capacityPerSource = 1024u,
+		             FullQueue fullQueue = FullQueue::Spin)
+			: target_ {target}
+			, keyOf_ {std::move(keyOf)}
+			, window_ {window}
+			, fullQueue_ {fullQueue}
+		{
+			sources_.reserve(sources);
+			for (std::size_t i = 0; i != sources; ++i) {
+				sources_.push_back(std::make_unique<Source>(*this, capacityPerSource));
+			}
+			inHeap_.resize(sources, false);
+			watermarks_.resize(sources, std::numeric_limits<key_type>::min());
+		}
+
+		OrderedFanIn(OrderedFanIn const&) = delete;
+		OrderedFanIn& operator=(OrderedFanIn const&) = delete;
+
+		//attach it to i-th Publisher
+		ObserverType* source(std::size_t i) noexcept {
+			return sources_[i].get();
+		}
+
+		std::size_t sourcesCount() const noexcept {
+			return sources_.size();
+		}
+
+		//consumer side, returns number of delivered items
+		std::size_t drain(std::size_t maxBatch = std::numeric_limits<std::size_t>::max()) {
+			std::size_t delivered {0u};
+			for (std::size_t i = 0; i != sources_.size(); ++i) {
+				if (!inHeap_[i] && sources_[i]->queue.read_available() != 0u) {
+					pushHead(i);
+				}
+			}
+			while (delivered < maxBatch && !heap_.empty()) {
+				auto const [key, i] = heap_.top();
+				Release const release {releasable(key)};
+				if (release == Release::Retry) {
+					continue;
+				}
+				if (release == Release::Wait) {
+					break;
+				}
+				heap_.pop();
+
+				Source& source {*sources_[i]};
+				Item const& item {source.queue.front()};
+				if (key < released_) {
+					++late_;
+				}
+				else {
+					released_ = key;
+				}
+				target_->updateCallback(item.event, item.value);
+				source.queue.pop();
+				++delivered;
+
+				if (source.queue.read_available() != 0u) {
+					pushHead(i);
+				}
+				else {
+					leaveHeap(i, key);
+				}
+			}
+			return delivered;
+		}
+
+		std::size_t late() const noexcept {
+			return late_;
+		}
+
+		//items dropped on a full queue with FullQueue::Drop, over all sources
+		std::size_t dropped() const noexcept {
+			std::size_t total {0u};
+			for (auto const& source : sources_) {
+				total += source->dropped.load(std::memory_order_relaxed);
+			}
+			return total;
+		}
+
+	private:
+
+		struct Item {
+			key_type key;
+			Event event;
+			Value value;
+		};
+
+		class Source final : public ObserverType {
+		public:
+			Source(OrderedFanIn& owner, std::size_t capacity) : owner_ {owner}, queue {capacity} {}
+
+			void updateCallback(Event const& event, Value const& value) & override {
+				key_type const key {owner_.keyOf_(event, value)};
+				Item const item {key, event, value};
+				while (!queue.push(item)) {
+					if (owner_.fullQueue_ == FullQueue::Drop) {
+						dropped.fetch_add(1u, std::memory_order_relaxed);
+						return;
+					}
+					std::this_thread::yield();
+				}
+				watermark.store(key, std::memory_order_release);
+			}
+
+			OrderedFanIn& owner_;
+			boost::lockfree::spsc_queue<Item> queue;
+			alignas(cacheLineSize) std::atomic<key_type> watermark {std::numeric_limits<key_type>::min()};
+			std::atomic<std::size_t> dropped {0u};
+		};
+
+		using Head = std::pair<key_type, std::size_t>;
+
+		enum class Release {
+			Now,
+			Wait,
+			Retry,
+		};
+
+		ObserverType* target_;
+		KeyOf keyOf_;
+		key_type window_;
+		FullQueue fullQueue_;
+		std::vector<std::unique_ptr<Source>> sources_;
+		std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap_;
+		std::vector<bool> inHeap_;
+		//consumer copy of the watermarks, never ahead of the real ones
+		std::vector<key_type> watermarks_;
+		//lowest copied watermark of the sources out of the heap, may be stale low, never high
+		key_type idleLow_ {std::numeric_limits<key_type>::min()};
+		key_type newest_ {std::numeric_limits<key_type>::min()};
+		key_type released_ {std::numeric_limits<key_type>::min()};
+		std::size_t late_ {0u};
+
+		void pushHead(std::size_t i) {
+			key_type const key {sources_[i]->queue.front().key};
+			heap_.emplace(key, i);
+			inHeap_[i] = true;
+			newest_ = std::max(newest_, key);
+		}
+
+		void leaveHeap(std::size_t i, key_type key) {
+			inHeap_[i] = false;
+			watermarks_[i] = std::max(watermarks_[i], key);
+			idleLow_ = std::min(idleLow_, watermarks_[i]);
+		}
+
+		Release releasable(key_type key) {
+			//anything an idle source pushes later is not before its watermark, so it can't go before the head
+			if (idleLow_ >= key) {
+				return Release::Now;
+			}
+			key_type low {std::numeric_limits<key_type>::max()};
+			bool waiting {false};
+			for (std::size_t j = 0; j != sources_.size(); ++j) {
+				if (inHeap_[j]) {
+					continue;
+				}
+				if (watermarks_[j] < key) {
+					//watermark first, it is stored after the push, so a queue is never seen behind it
+					key_type const watermark {sources_[j]->watermark.load(std::memory_order_acquire)};
+					if (sources_[j]->queue.read_available() != 0u) {
+						//arrived meanwhile, it may go before the current head
+						pushHead(j);
+						return Release::Retry;
+					}
+					watermarks_[j] = watermark;
+					newest_ = std::max(newest_, watermark);
+					waiting = waiting || watermark < key;
+				}
+				low = std::min(low, watermarks_[j]);
+			}
+			idleLow_ = low;
+			if (!waiting || pastWindow(key)) {
+				return Release::Now;
+			}
+			return Release::Wait;
+		}
+
+		bool pastWindow(key_type key) {
+			if (behindBy(key, newest_)) {
+				return true;
+			}
+			//sources in the heap may have got further than their heads, look once before waiting
+			for (auto const& source : sources_) {
+				newest_ = std::max(newest_, source->watermark.load(std::memory_order_acquire));
+			}
+			return behindBy(key, newest_);
+		}
+
+		//newest - key >= window, without overflow
+		bool behindBy(key_type key, key_type newest) const noexcept {
+			if (window_ <= key_type{0}) {
+				return true;
+			}
+			return key <= std::numeric_limits<key_type>::max() - window_ && key + window_ <= newest;
+		}
+	};
+
+	template<typename Event, typename Value, typename KeyOf>
+	auto makeOrderedFanIn(Observer<Event, Value>* target, KeyOf&& keyOf,
+	                      std::invoke_result_t<KeyOf, Event const&, Value const&> window,
+	                      std::size_t sources, std::size_t capacityPerSource = 1024u,
+	                      typename OrderedFanIn<Event, Value, std::decay_t<KeyOf>>::FullQueue fullQueue =
+	                              OrderedFanIn<Event, Value, std::decay_t<KeyOf>>::FullQueue::Spin) {
+		return std::make_unique<OrderedFanIn<Event, Value, std::decay_t<KeyOf>>>(
+				target, std::forward<KeyOf>(keyOf), window, sources, capacityPerSource, fullQueue);
+	}
+
+} //!namespace
@@ -8,14 +8,23 @@
 #include "requirements/comparator.h"
 #include "requirements/ctor_input.h"
 #include "requirements/container.h"
+#include "requirements/event_set.h"
+#include "small_vector.hpp"
 
 #include <boost/circular_buffer.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <functional>
+#include <string_view>
+#include <utility>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace culib::patterns {
+
+	static constexpr inline std::size_t cacheLineSize {64u};
 	
 	/**
 	 * @dev
@@ -133,18 +142,83 @@ namespace culib::patterns {
 		std::size_t eventsLength {1u};
 	};
 
-	template<typename Event, typename Value, typename Hash = std::hash<Event>, typename Equal = std::equal_to<Event>>
+	/**
+	 * @dev
+	 * Closed set of string events, known at compile time.
+	 * Index of a name is resolved in constexpr, therefore it is a perfect hash
+	 * for the set, and a Publisher keyed by EventSet never hashes an event.
+	 * Usage:
+	 * using Quotes = EventSet<"bid", "ask">;
+	 * publisher.template pushUpdate<Quotes{"ask"}>(value);
+	 *
+	 **/
+	template<::culib::requirements::FixedString... Names>
+	struct EventSet {
+		static constexpr std::size_t event_count {sizeof...(Names)};
+		static constexpr std::array<std::string_view, event_count> names {Names.view()...};
+
+		static constexpr std::size_t indexOf(std::string_view name) noexcept {
+			for (std::size_t i = 0; i != event_count; ++i) {
+				if (names[i] == name) {
+					return i;
+				}
+			}
+			return event_count;
+		}
+
+		//literal must be a member of the set, otherwise it doesn't compile
+		template<std::size_t N>
+		consteval EventSet(char const (&name)[N]) : idx {indexOf(std::string_view{name, N - 1u})} {
+			if (idx == event_count) {
+				throw "EventSet: name is not a member of the set";
+			}
+		}
+
+		//runtime lookup, unknown name results in an invalid event, that is never published
+		static constexpr EventSet fromName(std::string_view name) noexcept {
+			return EventSet{indexOf(name), Tag{}};
+		}
+
+		constexpr std::size_t index() const noexcept { return idx; }
+		constexpr bool valid() const noexcept { return idx < event_count; }
+		constexpr std::string_view name() const noexcept { return valid() ? names[idx] : std::string_view{}; }
+
+		constexpr bool operator==(EventSet const&) const noexcept = default;
+
+		//public to keep EventSet structural, so it can be used as NTTP
+		std::size_t idx;
+
+	private:
+		struct Tag {};
+		constexpr EventSet(std::size_t i, Tag) noexcept : idx {i} {}
+	};
+
+	//see snapshot.hpp
+	template<typename PublisherType>
+	class TopologySnapshot;
+
+	/**
+	 * @dev
+	 * InlineObservers is the number of subscribers per Event stored right in the registry entry,
+	 * past that subscribers list goes to heap.
+	 *
+	 **/
+	template<typename Event, typename Value, typename Hash = std::hash<Event>, typename Equal = std::equal_to<Event>,
+	         std::size_t InlineObservers = 4u>
 	requires ::culib::requirements::IsHash<Event, Hash> && ::culib::requirements::IsComparator<Event, Equal>
 	class Publisher {
+		friend class TopologySnapshot<Publisher<Event, Value, Hash, Equal, InlineObservers>>;
+
 	public:
 
 		using event_type = Event;
 		using value_type = Value;
 		using hash_type = Hash;
 		using equality_type = Equal;
-		using publisher_type = Publisher<Event, Value, Hash, Equal>;
+		using publisher_type = Publisher<Event, Value, Hash, Equal, InlineObservers>;
 
 		using ObserverType = Observer<event_type, value_type>;
+		using Subscribers = SmallVector<std::pair<int, ObserverType*>, InlineObservers>;
 
 		Publisher() = default;
 		virtual ~Publisher() = default;
@@ -182,7 +256,7 @@ namespace culib::patterns {
 		}
 
 		void pushUpdate(Event const& event, Value const& newValue) const & {
-			std::vector<std::pair<int, ObserverType*>> const& relevantObservers { getObservers(event) };
+			Subscribers const& relevantObservers { getObservers(event) };
 			//todo optimizable for work contracts
 			for (auto [niceValue, observerPtr] : relevantObservers) {
 				observerPtr->updateCallback(event, newValue);
@@ -191,12 +265,22 @@ namespace culib::patterns {
 
 		void addEvent (Event const& event) & {
 			if (!eventExists(event)) {
-				events_.emplace(event, std::vector<std::pair<int, ObserverType*>>{});
+				events_.emplace(event, Subscribers{});
 			}
 		}
 
 		void removeEvent (Event const& event) & {
-			events_.erase(event);
+			auto foundEvent = events_.find(event);
+			if (foundEvent == events_.end()) {
+				return;
+			}
+			//reverse index too, otherwise a re-added event can't be booked again
+			for (auto [niceValue, observerPtr] : foundEvent->second) {
+				if (auto foundObserver = observers.find(observerPtr); foundObserver != observers.end()) {
+					foundObserver->second.erase(event);
+				}
+			}
+			events_.erase(foundEvent);
 		}
 
 		bool eventExists (Event const& event) const & noexcept {
@@ -212,7 +296,7 @@ namespace culib::patterns {
 			return foundSubscription != foundObserver->second.end();
 		}
 
-		std::vector<std::pair<int, ObserverType*>> const& getObservers(Event const& event) const & noexcept {
+		Subscribers const& getObservers(Event const& event) const & noexcept {
             auto foundObservers = events_.find(event);
             if (foundObservers == events_.end()) {
                 return emptyObservers;
@@ -223,8 +307,8 @@ namespace culib::patterns {
 	protected:
         //todo - optimizable, Event can be heavy (unlikely, but...)
         std::unordered_map<ObserverType*, std::unordered_set<Event, Hash, Equal>> observers;
-        static constexpr inline std::vector<std::pair<int, ObserverType*>> emptyObservers {};
-        std::unordered_map<Event, std::vector<std::pair<int, ObserverType*>>, Hash, Equal> events_;
+        static inline Subscribers const emptyObservers {};
+        std::unordered_map<Event, Subscribers, Hash, Equal> events_;
     
     protected:
     
@@ -245,23 +329,10 @@ namespace culib::patterns {
                 }
             }
 			
-			std::vector<std::pair<int, ObserverType*>> & relevantObservers {foundEvent->second};
-            if (relevantObservers.empty()) {
-                relevantObservers.reserve(4u); //arbitrary figure, expected observes quantity
-                relevantObservers.emplace_back(niceValue, observer);
-            }
-            else {
-                relevantObservers.emplace_back(niceValue, observer);
-                auto iterNewElem {std::prev(relevantObservers.end(), 1)};
-                //debug build check
-                assert(relevantObservers.size() >= 2u);
-                auto iterEvents {std::prev(relevantObservers.end(), 2)};
-                while (iterEvents >= relevantObservers.begin() && iterEvents->first > niceValue) {
-                    std::iter_swap(iterEvents, iterNewElem);
-                    --iterNewElem;
-                    --iterEvents;
-                }
-            }
+			Subscribers & relevantObservers {foundEvent->second};
+			auto position {std::upper_bound(relevantObservers.begin(), relevantObservers.end(), niceValue,
+			                                [](int nice, auto const& elem) { return nice < elem.first; })};
+			relevantObservers.emplace(position, niceValue, observer);
             observers[observer].emplace(event);
 			observer->bookEvent(event);
 		}
@@ -271,7 +342,7 @@ namespace culib::patterns {
             if (foundObservers == events_.end()) {
                 return;
             }
-			std::vector<std::pair<int, ObserverType*>> & relevantObservers {foundObservers->second};
+			Subscribers & relevantObservers {foundObservers->second};
             auto found {std::find_if(relevantObservers.begin(), relevantObservers.end(), [observer](auto elem){
                 return elem.second == observer;
             })};
@@ -283,6 +354,187 @@ namespace culib::patterns {
 		}
 	};
 
+	/**
+	 * @dev
+	 * Publisher for a closed set of Events, i.e. enum with Count enumerator or EventSet<"...">.
+	 * Registry is a std::array indexed by event index, an Event is never hashed.
+	 * Publish does no hashing at all; Attach, Detach and hasSubscription still hash
+	 * the observer pointer, reverse index is keyed by it.
+	 * Publish to an event known at compile time is a direct array access:
+	 * publisher.template pushUpdate<Event::Some>(value);
+	 *
+	 **/
+	template<typename Event, typename Value, typename Hash, typename Equal, std::size_t InlineObservers>
+	requires ::culib::requirements::IsHash<Event, Hash> && ::culib::requirements::IsComparator<Event, Equal> &&
+	         ::culib::requirements::IsClosedEventSet<Event>
+	class Publisher<Event, Value, Hash, Equal, InlineObservers> {
+	public:
+
+		using event_type = Event;
+		using value_type = Value;
+		using hash_type = Hash;
+		using equality_type = Equal;
+		using publisher_type = Publisher<Event, Value, Hash, Equal, InlineObservers>;
+
+		using ObserverType = Observer<event_type, value_type>;
+		using Subscribers = SmallVector<std::pair<int, ObserverType*>, InlineObservers>;
+
+		static constexpr std::size_t event_count { ::culib::requirements::event_set_size_v<Event> };
+
+		Publisher() = default;
+		virtual ~Publisher() = default;
+
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		void Attach(ObserverType *observer, int niceValue, Events const&... events) &
+		{
+			(AttachImpl(observer, niceValue, events), ...);
+		}
+
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		void Detach(ObserverType *observer, Events const&... events) &
+		{
+			(DetachImpl(observer, events), ...);
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		void Attach(ObserverType *observer, int niceValue, Container const& events) &
+		{
+			for (auto const& event : events) {
+				AttachImpl(observer, niceValue, event);
+			}
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		void Detach(ObserverType *observer, Container const& events) &
+		{
+			for (auto const& event : events) {
+				DetachImpl(observer, event);
+			}
+		}
+
+		void pushUpdate(Event const& event, Value const& newValue) const & {
+			std::size_t const idx {indexOf(event)};
+			if (idx >= event_count) {
+				return;
+			}
+			for (auto [niceValue, observerPtr] : events_[idx]) {
+				observerPtr->updateCallback(event, newValue);
+			}
+		}
+
+		template<Event event>
+		void pushUpdate(Value const& newValue) const & {
+			static constexpr std::size_t idx {indexOf(event)};
+			static_assert(idx < event_count, "Event is out of the closed set");
+			for (auto [niceValue, observerPtr] : events_[idx]) {
+				observerPtr->updateCallback(event, newValue);
+			}
+		}
+
+		void addEvent (Event const& event) & {
+			if (std::size_t const idx {indexOf(event)}; idx < event_count) {
+				added_.set(idx);
+			}
+		}
+
+		void removeEvent (Event const& event) & {
+			std::size_t const idx {indexOf(event)};
+			if (idx >= event_count) {
+				return;
+			}
+			for (auto [niceValue, observerPtr] : events_[idx]) {
+				observers[observerPtr].reset(idx);
+			}
+			events_[idx].clear();
+			added_.reset(idx);
+		}
+
+		bool eventExists (Event const& event) const & noexcept {
+			std::size_t const idx {indexOf(event)};
+			return idx < event_count && added_.test(idx);
+		}
+
+		bool hasSubscription(ObserverType *observer, Event const& event) const & noexcept {
+			std::size_t const idx {indexOf(event)};
+			if (idx >= event_count) {
+				return false;
+			}
+			auto foundObserver = observers.find(observer);
+			if (foundObserver == observers.end()) {
+				return false;
+			}
+			return foundObserver->second.test(idx);
+		}
+
+		Subscribers const& getObservers(Event const& event) const & noexcept {
+			std::size_t const idx {indexOf(event)};
+			if (idx >= event_count) {
+				return emptyObservers;
+			}
+			return events_[idx];
+		}
+
+	protected:
+		std::unordered_map<ObserverType*, std::bitset<event_count>> observers;
+		static inline Subscribers const emptyObservers {};
+		std::array<Subscribers, event_count> events_;
+		std::bitset<event_count> added_;
+
+	protected:
+
+		static constexpr std::size_t indexOf(Event const& event) noexcept {
+			if constexpr (::culib::requirements::IsEnumEventSet<Event>) {
+				//negative values turn into huge ones and are rejected by bounds check
+				return static_cast<std::size_t>(std::to_underlying(event));
+			}
+			else {
+				return event.index();
+			}
+		}
+
+		void AttachImpl(ObserverType *observer, int niceValue, Event const& event) {
+			std::size_t const idx {indexOf(event)};
+			if (idx >= event_count || !added_.test(idx)) {
+				//todo must be logged, no event
+				return;
+			}
+			auto& booked {observers[observer]};
+			if (booked.test(idx)) {
+				//todo must be logged, observer already booked for event
+				return;
+			}
+
+			Subscribers & relevantObservers {events_[idx]};
+			auto position {std::upper_bound(relevantObservers.begin(), relevantObservers.end(), niceValue,
+			                                [](int nice, auto const& elem) { return nice < elem.first; })};
+			relevantObservers.emplace(position, niceValue, observer);
+			booked.set(idx);
+			observer->bookEvent(event);
+		}
+
+		void DetachImpl(ObserverType *observer, Event const& event) {
+			std::size_t const idx {indexOf(event)};
+			if (idx >= event_count) {
+				return;
+			}
+			Subscribers & relevantObservers {events_[idx]};
+			auto found {std::find_if(relevantObservers.begin(), relevantObservers.end(), [observer](auto elem){
+				return elem.second == observer;
+			})};
+			if (found != relevantObservers.end()) {
+				relevantObservers.erase(found);
+			}
+			if (auto foundObserver = observers.find(observer); foundObserver != observers.end()) {
+				foundObserver->second.reset(idx);
+			}
+			observer->removeEvent(event);
+		}
+	};
+
 	template<typename Publisher, typename Observer>
 	static constexpr inline bool checkPublisherObserver () {
 		static_assert(std::is_same_v<typename Publisher::event_type, typename Observer::event_type>, "Event types are different");
@@ -0,0 +1,462 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include "observer.hpp"
+#include "gated_publisher.hpp"
+
+#include <boost/lockfree/policies.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+namespace culib::patterns {
+
+	/**
+	 * @dev
+	 * Where Observer's work runs: a core, or any core of a NUMA node.
+	 * Core wins, if both are set; node of a core is looked up in sysfs.
+	 * Pinning and node local memory are Linux only, elsewhere placement
+	 * only groups observers by worker thread.
+	 *
+	 **/
+	struct Placement {
+		int core {-1};
+		int node {-1};
+
+		static Placement onCore(int core) noexcept { return Placement{core, -1}; }
+		static Placement onNode(int node) noexcept { return Placement{-1, node}; }
+	};
+
+	namespace numa {
+
+		inline int nodeOfCore(int core) {
+#ifdef __linux__
+			std::error_code ec;
+			std::filesystem::path const dir {"/sys/devices/system/cpu/cpu" + std::to_string(core)};
+			for (auto const& entry : std::filesystem::directory_iterator(dir, ec)) {
+				std::string const name {entry.path().filename().string()};
+				if (name.size() > 4u && name.starts_with("node")) {
+					return std::stoi(name.substr(4u));
+				}
+			}
+#endif
+			(void)core;
+			return 0;
+		}
+
+		inline std::vector<int> coresOfNode(int node) {
+			std::vector<int> cores;
+#ifdef __linux__
+			std::ifstream cpulist {"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+			std::string range;
+			//format is "0-3,8-11"
+			while (std::getline(cpulist, range, ',')) {
+				auto const dash {range.find('-')};
+				int const first {std::stoi(range.substr(0u, dash))};
+				int const last {dash == std::string::npos ? first : std::stoi(range.substr(dash + 1u))};
+				for (int core = first; core <= last; ++core) {
+					cores.push_back(core);
+				}
+			}
+#endif
+			(void)node;
+			return cores;
+		}
+
+		inline int currentNode() {
+#ifdef __linux__
+			int const core {::sched_getcpu()};
+			return core < 0 ? 0 : nodeOfCore(core);
+#else
+			return 0;
+#endif
+		}
+
+		inline bool pinCurrentThread(std::vector<int> const& cores) noexcept {
+#ifdef __linux__
+			if (cores.empty()) {
+				return false;
+			}
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			for (int core : cores) {
+				CPU_SET(core, &set);
+			}
+			return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+			(void)cores;
+			return false;
+#endif
+		}
+
+		//pages are bound to node before the first touch, falls back to regular pages silently
+		inline void* allocateOnNode(std::size_t bytes, int node) {
+			void* addr {::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+			if (addr == MAP_FAILED) {
+				throw std::bad_alloc{};
+			}
+#ifdef __linux__
+			if (node >= 0 && node < 64) {
+				constexpr int mpolPreferred {1};
+				unsigned long const nodemask {1ul << node};
+				::syscall(SYS_mbind, addr, bytes, mpolPreferred, &nodemask, 64ul, 0u);
+			}
+#endif
+			(void)node;
+			return addr;
+		}
+
+		inline void deallocateOnNode(void* addr, std::size_t bytes) noexcept {
+			::munmap(addr, bytes);
+		}
+
+	}//!namespace numa
+
+
+	template<typename T>
+	struct NodeLocalAllocator {
+		using value_type = T;
+
+		template<typename U>
+		struct rebind { using other = NodeLocalAllocator<U>; };
+
+		int node {-1};
+
+		NodeLocalAllocator() noexcept = default;
+		explicit NodeLocalAllocator(int n) noexcept : node {n} {}
+		template<typename U>
+		NodeLocalAllocator(NodeLocalAllocator<U> const& other) noexcept : node {other.node} {}
+
+		T* allocate(std::size_t n) {
+			return static_cast<T*>(numa::allocateOnNode(roundUp(n * sizeof(T)), node));
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept {
+			numa::deallocateOnNode(p, roundUp(n * sizeof(T)));
+		}
+
+		template<typename U>
+		bool operator==(NodeLocalAllocator<U> const& other) const noexcept { return node == other.node; }
+
+	private:
+		static std::size_t roundUp(std::size_t bytes) noexcept {
+			std::size_t const page {static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+			return (bytes + page - 1u) / page * page;
+		}
+	};
+
+
+	/**
+	 * @dev
+	 * Publisher that runs updateCallback of placed Observers on worker threads.
+	 * There is a worker per Placement, pinned to its core or node, and its inbox
+	 * is allocated on that node, so Observer reads deliveries from local memory.
+	 * Deliveries to a worker on the publisher's own node go to the inbox right away,
+	 * deliveries to other nodes are staged and pushed at the end of pushUpdate,
+	 * or by batches of crossNodeBatch if one publish stages more, so the interconnect sees
+	 * a transfer per publish and worker, not per observer. Nothing stays staged past
+	 * pushUpdate, unless it is called through a base Publisher; call flush() then.
+	 * Observers attached with no Placement are called on the publisher thread, as usual.
+	 * Idle worker polls its inbox idleSpins times, yielding in between, and then parks
+	 * on an atomic wait; a push costs an atomic exchange, plus a notify if the worker is parked. idleSpins of neverPark keeps workers spinning for the
+	 * lowest latency, at the price of a core each.
+	 * Observers allocating their own state from updateCallback get node local
+	 * memory by first touch, since it runs on the pinned worker.
+	 *
+	 **/
+	template<typename Event, typename Value, typename Hash = std::hash<Event>, typename Equal = std::equal_to<Event>>
+	class PlacedPublisher : public details::GatedPublisher<Event, Value, Hash, Equal> {
+	public:
+
+		using GatedBase = details::GatedPublisher<Event, Value, Hash, Equal>;
+		using PublisherBase = typename GatedBase::PublisherBase;
+		using ObserverType = typename PublisherBase::ObserverType;
+
+		static constexpr std::size_t neverPark {std::numeric_limits<std::size_t>::max()};
+
+		explicit PlacedPublisher(std::size_t inboxCapacity = 4096u, std::size_t crossNodeBatch = 64u,
+		                         std::size_t idleSpins = 1024u)
+			: inboxCapacity_ {inboxCapacity}
+			, crossNodeBatch_ {crossNodeBatch == 0u ? 1u : crossNodeBatch}
+			, idleSpins_ {idleSpins}
+			, homeNode_ {numa::currentNode()}
+		{}
+
+		~PlacedPublisher() override {
+			flush();
+			for (auto& [key, worker] : workers_) {
+				worker->stop();
+			}
+		}
+
+		using GatedBase::Attach;
+
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		void Attach(ObserverType *observer, int niceValue, Placement const& placement, Events const&... events) &
+		{
+			(AttachPlacedImpl(observer, niceValue, placement, events), ...);
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		void Attach(ObserverType *observer, int niceValue, Placement const& placement, Container const& events) &
+		{
+			for (auto const& event : events) {
+				AttachPlacedImpl(observer, niceValue, placement, event);
+			}
+		}
+
+		void pushUpdate(Event const& event, Value const& newValue) const & {
+			PublisherBase::pushUpdate(event, newValue);
+			flushStaged();
+		}
+
+		//pushes staged cross node deliveries
+		void flush() & {
+			for (auto& [key, worker] : workers_) {
+				worker->flush();
+			}
+			stagedWorkers_.clear();
+		}
+
+		//blocks until every worker has processed what was pushed so far
+		void drain() & {
+			flush();
+			for (auto& [key, worker] : workers_) {
+				worker->waitEmpty();
+			}
+		}
+
+		int homeNode() const noexcept { return homeNode_; }
+
+	private:
+
+		struct Delivery {
+			ObserverType* target {nullptr};
+			Event event {};
+			Value value {};
+		};
+
+		class Worker {
+		public:
+			Worker(std::vector<int> cores, int node, bool remote, std::size_t capacity, std::size_t batch, std::size_t idleSpins)
+				: node_ {node}
+				, remote_ {remote}
+				, batch_ {batch}
+				, idleSpins_ {idleSpins}
+				, inbox_ {capacity, NodeLocalAllocator<Delivery>{node}}
+			{
+				staged_.reserve(batch_);
+				thread_ = std::thread([this, cores = std::move(cores)] {
+					numa::pinCurrentThread(cores);
+					run();
+				});
+			}
+
+			//true if it has started staging, so the worker is to be flushed
+			bool enqueue(ObserverType* target, Event const& event, Value const& value) {
+				if (!remote_) {
+					push(Delivery{target, event, value});
+					return false;
+				}
+				bool const first {staged_.empty()};
+				staged_.push_back(Delivery{target, event, value});
+				if (staged_.size() >= batch_) {
+					flush();
+				}
+				return first && !staged_.empty();
+			}
+
+			void flush() {
+				if (staged_.empty()) {
+					return;
+				}
+				Delivery const* begin {staged_.data()};
+				std::size_t left {staged_.size()};
+				while (left != 0u) {
+					std::size_t const pushed {inbox_.push(begin, left)};
+					begin += pushed;
+					left -= pushed;
+					if (left != 0u) {
+						wake();
+						std::this_thread::yield();
+					}
+				}
+				staged_.clear();
+				wake();
+			}
+
+			void waitEmpty() const {
+				while (inbox_.read_available() != 0u || busy_.load(std::memory_order_acquire)) {
+					std::this_thread::yield();
+				}
+			}
+
+			void stop() {
+				stop_.store(true, std::memory_order_release);
+				wake();
+				if (thread_.joinable()) {
+					thread_.join();
+				}
+			}
+
+			int node() const noexcept { return node_; }
+
+		private:
+			int node_;
+			bool remote_;
+			std::size_t batch_;
+			std::size_t idleSpins_;
+			std::vector<Delivery> staged_;
+			boost::lockfree::spsc_queue<Delivery, boost::lockfree::allocator<NodeLocalAllocator<Delivery>>> inbox_;
+			alignas(cacheLineSize) std::atomic<bool> busy_ {false};
+			std::atomic<bool> stop_ {false};
+			std::atomic<bool> parked_ {false};
+			std::thread thread_;
+
+			void push(Delivery const& delivery) {
+				while (!inbox_.push(delivery)) {
+					wake();
+					std::this_thread::yield();
+				}
+				wake();
+			}
+
+			//both sides exchange parked_, so either the worker sees the push, or this sees it parked
+			void wake() {
+				if (parked_.exchange(false, std::memory_order_acq_rel)) {
+					parked_.notify_one();
+				}
+			}
+
+			void park() {
+				parked_.exchange(true, std::memory_order_acq_rel);
+				if (inbox_.read_available() != 0u || stop_.load(std::memory_order_acquire)) {
+					parked_.store(false, std::memory_order_relaxed);
+					return;
+				}
+				parked_.wait(true, std::memory_order_acquire);
+			}
+
+			void run() {
+				auto const deliver = [](Delivery const& d) { d.target->updateCallback(d.event, d.value); };
+				std::size_t idle {0u};
+				while (true) {
+					busy_.store(true, std::memory_order_release);
+					std::size_t const consumed {inbox_.consume_all(deliver)};
+					busy_.store(false, std::memory_order_release);
+					if (consumed == 0u) {
+						if (stop_.load(std::memory_order_acquire)) {
+							if (inbox_.read_available() == 0u) {
+								return;
+							}
+							continue;
+						}
+						if (idle < idleSpins_) {
+							++idle;
+							std::this_thread::yield();
+						}
+						else {
+							park();
+							idle = 0u;
+						}
+					}
+					else {
+						idle = 0u;
+					}
+				}
+			}
+		};
+
+		class Gate final : public details::Gate<Event, Value> {
+		public:
+			Gate(PlacedPublisher const& owner, Worker& worker, ObserverType* target, Event const& event)
+				: details::Gate<Event, Value>(target, event), owner_ {owner}, worker_ {worker}
+			{}
+
+			void updateCallback(Event const& event, Value const& value) & override {
+				if (worker_.enqueue(this->target_, event, value)) {
+					owner_.stagedWorkers_.push_back(&worker_);
+				}
+			}
+
+			Worker& worker() const noexcept { return worker_; }
+
+		private:
+			PlacedPublisher const& owner_;
+			Worker& worker_;
+		};
+
+		std::size_t inboxCapacity_;
+		std::size_t crossNodeBatch_;
+		std::size_t idleSpins_;
+		int homeNode_;
+		//key is core for core placement, -(node + 1) for node placement
+		std::map<int, std::unique_ptr<Worker>> workers_;
+		//remote workers with staged deliveries, filled on the publish path
+		mutable std::vector<Worker*> stagedWorkers_;
+
+		void flushStaged() const {
+			for (Worker* worker : stagedWorkers_) {
+				worker->flush();
+			}
+			stagedWorkers_.clear();
+		}
+
+		Worker& workerFor(Placement const& placement) {
+			int const key {placement.core >= 0 ? placement.core : -(std::max(placement.node, 0) + 1)};
+			auto found = workers_.find(key);
+			if (found != workers_.end()) {
+				return *found->second;
+			}
+			std::vector<int> cores;
+			int node;
+			if (placement.core >= 0) {
+				cores.push_back(placement.core);
+				node = numa::nodeOfCore(placement.core);
+			}
+			else {
+				node = std::max(placement.node, 0);
+				cores = numa::coresOfNode(node);
+			}
+			auto worker {std::make_unique<Worker>(std::move(cores), node, node != homeNode_, inboxCapacity_, crossNodeBatch_, idleSpins_)};
+			return *workers_.emplace(key, std::move(worker)).first->second;
+		}
+
+		void AttachPlacedImpl(ObserverType *observer, int niceValue, Placement const& placement, Event const& event) {
+			this->AttachGatedImpl(observer, niceValue, event, [&] {
+				return std::make_unique<Gate>(*this, workerFor(placement), observer, event);
+			});
+		}
+
+		void onGateDetached(typename GatedBase::GateType& gate) override {
+			//deliveries already queued still reach the observer, only its own worker is waited for
+			Worker& worker {static_cast<Gate&>(gate).worker()};
+			worker.flush();
+			worker.waitEmpty();
+		}
+	};
+
+} //!namespace
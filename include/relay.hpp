@@ -0,0 +1,120 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include "observer.hpp"
+
+#include <tuple>
+#include <utility>
+
+namespace culib::patterns {
+
+	/**
+	 * @dev
+	 * Stage is a callable stage(event, value, emit), where emit(outEvent, outValue)
+	 * hands the result downstream. A stage may emit zero, one or many times.
+	 * Stages are composed at compile time:
+	 * fuse(a, b, c) - a feeds b, b feeds c;
+	 * fanOut(a, b)  - both a and b receive the same input and emit into the same downstream.
+	 * Nesting fuse and fanOut builds a DAG, that is flattened into one inlined call chain,
+	 * with no hash lookup and no virtual call between stages.
+	 * Relay is the boundary of such a chain: it is an Observer of its input and a Publisher
+	 * of its output, so chains that run on different threads (or are owned by different
+	 * components) are linked by regular Attach.
+	 *
+	 **/
+
+	namespace details {
+
+		template<typename... Stages>
+		struct Fused {
+			std::tuple<Stages...> stages;
+
+			template<typename Event, typename Value, typename Emit>
+			void operator()(Event const& event, Value const& value, Emit&& emit) {
+				invoke<0u>(event, value, emit);
+			}
+
+		private:
+			template<std::size_t I, typename Event, typename Value, typename Emit>
+			void invoke(Event const& event, Value const& value, Emit& emit) {
+				if constexpr (I + 1u == sizeof...(Stages)) {
+					std::get<I>(stages)(event, value, emit);
+				}
+				else {
+					auto next = [this, &emit](auto const& e, auto const& v) {
+						this->template invoke<I + 1u>(e, v, emit);
+					};
+					std::get<I>(stages)(event, value, next);
+				}
+			}
+		};
+
+		template<typename... Branches>
+		struct FanOut {
+			std::tuple<Branches...> branches;
+
+			template<typename Event, typename Value, typename Emit>
+			void operator()(Event const& event, Value const& value, Emit&& emit) {
+				std::apply([&](auto&... branch) {
+					(branch(event, value, emit), ...);
+				}, branches);
+			}
+		};
+
+	}//!namespace details
+
+	template<typename... Stages>
+	requires (sizeof...(Stages) > 0u)
+	constexpr auto fuse(Stages&&... stages) {
+		return details::Fused<std::decay_t<Stages>...>{ {std::forward<Stages>(stages)...} };
+	}
+
+	template<typename... Branches>
+	requires (sizeof...(Branches) > 0u)
+	constexpr auto fanOut(Branches&&... branches) {
+		return details::FanOut<std::decay_t<Branches>...>{ {std::forward<Branches>(branches)...} };
+	}
+
+
+	template<typename InEvent, typename InValue, typename OutEvent, typename OutValue, typename Stage>
+	class Relay : public Observer<InEvent, InValue>, public Publisher<OutEvent, OutValue> {
+	public:
+
+		using ObserverBase = Observer<InEvent, InValue>;
+		using PublisherBase = Publisher<OutEvent, OutValue>;
+		using input_event_type = InEvent;
+		using input_value_type = InValue;
+		using output_event_type = OutEvent;
+		using output_value_type = OutValue;
+		//both bases have them, downstream view wins, use ObserverBase to check against upstream
+		using event_type = typename PublisherBase::event_type;
+		using value_type = typename PublisherBase::value_type;
+
+		explicit Relay(Stage stage) : stage_ {std::move(stage)} {}
+
+		//publisher side, observer side is used by upstream Publisher only
+		using PublisherBase::addEvent;
+		using PublisherBase::removeEvent;
+
+		void updateCallback(InEvent const& event, InValue const& value) & override {
+			stage_(event, value, [this](OutEvent const& outEvent, OutValue const& outValue) {
+				this->pushUpdate(outEvent, outValue);
+			});
+		}
+
+		Stage& stage() & noexcept { return stage_; }
+		Stage const& stage() const & noexcept { return stage_; }
+
+	private:
+		Stage stage_;
+	};
+
+	template<typename InEvent, typename InValue, typename OutEvent = InEvent, typename OutValue = InValue, typename Stage>
+	auto makeRelay(Stage&& stage) {
+		return Relay<InEvent, InValue, OutEvent, OutValue, std::decay_t<Stage>>{std::forward<Stage>(stage)};
+	}
+
+} //!namespace
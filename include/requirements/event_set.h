@@ -0,0 +1,72 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <concepts>
+
+namespace culib::requirements {
+	/**
+	 * @brief
+	 * string literal usable as a non-type template parameter,
+	 * i.e. EventSet<"bid", "ask">
+	 * */
+	template<std::size_t N>
+	struct FixedString {
+		char value[N] {};
+
+		constexpr FixedString(char const (&str)[N]) noexcept {
+			std::copy_n(str, N, value);
+		}
+
+		constexpr std::string_view view() const noexcept {
+			return {value, N - 1u};
+		}
+
+		constexpr std::size_t size() const noexcept {
+			return N - 1u;
+		}
+	};
+
+	/**
+	 * @brief
+	 * check that Event type has a closed set of values, known at compile time.
+	 * Either an enum with the last enumerator named Count, or a type that
+	 * exposes static constexpr event_count and constexpr index() method.
+	 * */
+	template<typename Event>
+	concept IsEnumEventSet = std::is_enum_v<Event> && requires {
+		Event::Count;
+		requires static_cast<std::size_t>(Event::Count) > 0u;
+	};
+
+	template<typename Event>
+	concept IsIndexedEventSet = std::is_class_v<Event> && requires (Event const e) {
+		{ Event::event_count } -> std::convertible_to<std::size_t>;
+		{ e.index() } noexcept -> std::same_as<std::size_t>;
+	};
+
+	template<typename Event>
+	concept IsClosedEventSet = IsEnumEventSet<Event> || IsIndexedEventSet<Event>;
+
+	template<typename Event>
+	static constexpr inline bool is_closed_event_set_v { IsClosedEventSet<Event> };
+
+	template<IsClosedEventSet Event>
+	static constexpr inline std::size_t event_set_size_v {
+		[] {
+			if constexpr (IsEnumEventSet<Event>) {
+				return static_cast<std::size_t>(Event::Count);
+			}
+			else {
+				return static_cast<std::size_t>(Event::event_count);
+			}
+		}()
+	};
+
+}//!namespace
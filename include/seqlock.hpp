@@ -0,0 +1,185 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include "observer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace culib::patterns {
+
+	/**
+	 * @dev
+	 * Single writer, many readers last value slot. Writer never waits for readers,
+	 * readers never block writer, torn read is detected by sequence and retried.
+	 * Payload is kept as atomic words, so concurrent read and write is not a data race.
+	 * Sequence is even when slot is stable, and sequence / 2 is a number of writes so far.
+	 *
+	 **/
+	template<typename Value>
+	requires std::is_trivially_copyable_v<Value> && std::is_default_constructible_v<Value>
+	class alignas(cacheLineSize) SeqlockSlot {
+	public:
+
+		using value_type = Value;
+
+		SeqlockSlot() noexcept = default;
+		SeqlockSlot(SeqlockSlot const&) = delete;
+		SeqlockSlot& operator=(SeqlockSlot const&) = delete;
+
+		void write(Value const& value) noexcept {
+			Word buffer[words] {};
+			std::memcpy(buffer, &value, sizeof(Value));
+
+			std::uint64_t const seq {seq_.load(std::memory_order_relaxed)};
+			seq_.store(seq + 1u, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			for (std::size_t i = 0; i != words; ++i) {
+				data_[i].store(buffer[i], std::memory_order_relaxed);
+			}
+			seq_.store(seq + 2u, std::memory_order_release);
+		}
+
+		//false if read was torn or write is in progress, value is untouched then
+		bool tryRead(Value& value, std::uint64_t& sequence) const noexcept {
+			std::uint64_t const before {seq_.load(std::memory_order_acquire)};
+			if ((before & 1u) != 0u) {
+				return false;
+			}
+			Word buffer[words];
+			for (std::size_t i = 0; i != words; ++i) {
+				buffer[i] = data_[i].load(std::memory_order_relaxed);
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (seq_.load(std::memory_order_relaxed) != before) {
+				return false;
+			}
+			std::memcpy(&value, buffer, sizeof(Value));
+			sequence = before / 2u;
+			return true;
+		}
+
+		std::uint64_t read(Value& value) const noexcept {
+			std::uint64_t sequence {0u};
+			while (!tryRead(value, sequence)) {
+#if defined(__x86_64__) || defined(__i386__)
+				__builtin_ia32_pause();
+#elif defined(__aarch64__)
+				asm volatile("yield");
+#endif
+			}
+			return sequence;
+		}
+
+		std::uint64_t sequence() const noexcept {
+			return seq_.load(std::memory_order_acquire) / 2u;
+		}
+
+	private:
+		using Word = std::uint64_t;
+		static constexpr std::size_t words {(sizeof(Value) + sizeof(Word) - 1u) / sizeof(Word)};
+
+		std::atomic<std::uint64_t> seq_ {0u};
+		std::atomic<Word> data_[words] {};
+	};
+
+
+	/**
+	 * @dev
+	 * Reader side of a slot, keeps the last seen sequence, so a poller knows
+	 * whether the value is fresh and how many updates it has missed since the last poll.
+	 *
+	 **/
+	template<typename Value>
+	class Poller {
+	public:
+
+		struct PollResult {
+			bool updated {false};
+			std::uint64_t missed {0u};
+			std::uint64_t sequence {0u};
+		};
+
+		Poller() noexcept = default;
+		explicit Poller(SeqlockSlot<Value> const* slot) noexcept : slot_ {slot} {}
+
+		//value is overwritten only if there is a new one
+		PollResult poll(Value& value) noexcept {
+			PollResult result;
+			if (slot_ == nullptr || slot_->sequence() == seen_) {
+				result.sequence = seen_;
+				return result;
+			}
+			result.sequence = slot_->read(value);
+			result.updated = result.sequence != seen_;
+			result.missed = result.updated ? result.sequence - seen_ - 1u : 0u;
+			seen_ = result.sequence;
+			return result;
+		}
+
+		bool valid() const noexcept { return slot_ != nullptr; }
+
+	private:
+		SeqlockSlot<Value> const* slot_ {nullptr};
+		std::uint64_t seen_ {0u};
+	};
+
+
+	/**
+	 * @dev
+	 * Poll mode subscription: attach it to a Publisher as any other Observer,
+	 * it keeps one slot per Event, so publish cost is one slot write
+	 * no matter how many pollers read that slot.
+	 * Slots are created by prepare() only, and it must be done before publishing starts
+	 * and before any poller is taken, same as Attach; after that the slot table is
+	 * read only, so publisher and pollers on other threads never race on it.
+	 * Update of an event that was not prepared is dropped, poller() of it is not valid().
+	 *
+	 **/
+	template<typename Event, typename Value, typename Hash = std::hash<Event>, typename Equal = std::equal_to<Event>>
+	class LastValueObserver final : public Observer<Event, Value> {
+	public:
+
+		using SlotType = SeqlockSlot<Value>;
+
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		void prepare(Events const&... events) & {
+			(slots_.try_emplace(events, std::make_unique<SlotType>()), ...);
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		void prepare(Container const& events) & {
+			for (auto const& event : events) {
+				slots_.try_emplace(event, std::make_unique<SlotType>());
+			}
+		}
+
+		void updateCallback(Event const& event, Value const& value) & override {
+			if (SlotType* slot {find(event)}; slot != nullptr) {
+				slot->write(value);
+			}
+			//todo must be logged, event was not prepared
+		}
+
+		Poller<Value> poller(Event const& event) const & {
+			return Poller<Value>{find(event)};
+		}
+
+	private:
+		std::unordered_map<Event, std::unique_ptr<SlotType>, Hash, Equal> slots_;
+
+		SlotType* find(Event const& event) const noexcept {
+			auto found = slots_.find(event);
+			return found == slots_.end() ? nullptr : found->second.get();
+		}
+	};
+
+} //!namespace
@@ -0,0 +1,186 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace culib::patterns {
+
+	/**
+	 * @dev
+	 * Vector with the first N elements stored inline, goes to heap only past that capacity.
+	 * Used as per Event subscribers list, where usually there are one to three Observers,
+	 * so the list lives right in the registry entry, no allocation and no pointer chase to reach it.
+	 * Iterators are raw pointers, invalidated on growth, same as std::vector.
+	 *
+	 **/
+	template<typename T, std::size_t N>
+	requires (N > 0u) && std::is_nothrow_move_constructible_v<T>
+	class SmallVector {
+	public:
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T&;
+		using const_reference = T const&;
+		using pointer = T*;
+		using const_pointer = T const*;
+		using iterator = T*;
+		using const_iterator = T const*;
+
+		static constexpr size_type inline_capacity {N};
+
+		SmallVector() noexcept = default;
+
+		SmallVector(SmallVector const& other) {
+			reserve(other.size_);
+			std::uninitialized_copy(other.begin(), other.end(), data_);
+			size_ = other.size_;
+		}
+
+		SmallVector(SmallVector&& other) noexcept {
+			moveFrom(std::move(other));
+		}
+
+		SmallVector& operator=(SmallVector const& other) {
+			if (this != &other) {
+				clear();
+				reserve(other.size_);
+				std::uninitialized_copy(other.begin(), other.end(), data_);
+				size_ = other.size_;
+			}
+			return *this;
+		}
+
+		SmallVector& operator=(SmallVector&& other) noexcept {
+			if (this != &other) {
+				clear();
+				releaseHeap();
+				moveFrom(std::move(other));
+			}
+			return *this;
+		}
+
+		~SmallVector() {
+			clear();
+			releaseHeap();
+		}
+
+		iterator begin() noexcept { return data_; }
+		const_iterator begin() const noexcept { return data_; }
+		const_iterator cbegin() const noexcept { return data_; }
+		iterator end() noexcept { return data_ + size_; }
+		const_iterator end() const noexcept { return data_ + size_; }
+		const_iterator cend() const noexcept { return data_ + size_; }
+
+		reference operator[](size_type i) noexcept { assert(i < size_); return data_[i]; }
+		const_reference operator[](size_type i) const noexcept { assert(i < size_); return data_[i]; }
+		reference front() noexcept { return data_[0]; }
+		const_reference front() const noexcept { return data_[0]; }
+		reference back() noexcept { return data_[size_ - 1u]; }
+		const_reference back() const noexcept { return data_[size_ - 1u]; }
+		pointer data() noexcept { return data_; }
+		const_pointer data() const noexcept { return data_; }
+
+		size_type size() const noexcept { return size_; }
+		size_type capacity() const noexcept { return capacity_; }
+		bool empty() const noexcept { return size_ == 0u; }
+		bool isInline() const noexcept { return data_ == inlineData(); }
+
+		void reserve(size_type capacity) {
+			if (capacity <= capacity_) {
+				return;
+			}
+			T* heap {static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{alignof(T)}))};
+			std::uninitialized_move(begin(), end(), heap);
+			std::destroy(begin(), end());
+			releaseHeap();
+			data_ = heap;
+			capacity_ = static_cast<std::uint32_t>(capacity);
+		}
+
+		template<typename... Args>
+		reference emplace_back(Args&&... args) {
+			if (size_ == capacity_) {
+				//construct first, args may refer to an element of this
+				T value (std::forward<Args>(args)...);
+				reserve(capacity_ * 2u);
+				return *std::construct_at(data_ + size_++, std::move(value));
+			}
+			return *std::construct_at(data_ + size_++, std::forward<Args>(args)...);
+		}
+
+		void push_back(T const& value) { emplace_back(value); }
+		void push_back(T&& value) { emplace_back(std::move(value)); }
+
+		template<typename... Args>
+		iterator emplace(const_iterator position, Args&&... args) {
+			difference_type const offset {position - begin()};
+			T value (std::forward<Args>(args)...);
+			emplace_back(std::move(value));
+			std::rotate(begin() + offset, end() - 1, end());
+			return begin() + offset;
+		}
+
+		iterator erase(const_iterator position) {
+			difference_type const offset {position - begin()};
+			std::move(begin() + offset + 1, end(), begin() + offset);
+			pop_back();
+			return begin() + offset;
+		}
+
+		void pop_back() noexcept {
+			std::destroy_at(data_ + --size_);
+		}
+
+		void clear() noexcept {
+			std::destroy(begin(), end());
+			size_ = 0u;
+		}
+
+		friend bool operator==(SmallVector const& lhs, SmallVector const& rhs) {
+			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+
+	private:
+		T* data_ {inlineData()};
+		std::uint32_t size_ {0u};
+		std::uint32_t capacity_ {N};
+		alignas(T) std::byte inline_[N * sizeof(T)];
+
+		T* inlineData() noexcept { return reinterpret_cast<T*>(inline_); }
+		T const* inlineData() const noexcept { return reinterpret_cast<T const*>(inline_); }
+
+		void releaseHeap() noexcept {
+			if (!isInline()) {
+				::operator delete(data_, std::align_val_t{alignof(T)});
+				data_ = inlineData();
+				capacity_ = N;
+			}
+		}
+
+		void moveFrom(SmallVector&& other) noexcept {
+			if (other.isInline()) {
+				std::uninitialized_move(other.begin(), other.end(), data_);
+				size_ = other.size_;
+				other.clear();
+			}
+			else {
+				data_ = std::exchange(other.data_, other.inlineData());
+				size_ = std::exchange(other.size_, 0u);
+				capacity_ = std::exchange(other.capacity_, N);
+			}
+		}
+	};
+
+} //!namespace
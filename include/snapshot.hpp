@@ -0,0 +1,402 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include "observer.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace culib::patterns {
+
+	/**
+	 * @dev
+	 * Binary image of a Publisher topology: events, niceValue ordered subscriber lists
+	 * and the reverse observers index. Observers are not pointers in the image, they are
+	 * referred by stable ids, provided by user on save and resolved back on load.
+	 * Layout, all integers are native endian, no padding:
+	 *   header    : magic[8], u32 version, u32 endianness tag, u64 observers, u64 events
+	 *   observers : {u64 id, u64 subscriptions} - reverse index, used to presize hash tables
+	 *   events    : {event, u32 n, n x {i32 niceValue, u32 observer index}}
+	 * Subscriber lists are stored already sorted, so load is a single pass with no
+	 * insertion sort and no rehash; the file is mmap-ed and read sequentially.
+	 *
+	 **/
+
+	enum class SnapshotStatus {
+		Ok,
+		IoError,
+		BadMagic,
+		BadVersion,
+		Truncated,
+		UnknownObserver,
+		Corrupt,
+	};
+
+	namespace details {
+
+		class SnapshotReader {
+		public:
+			explicit SnapshotReader(std::span<std::byte const> bytes) noexcept : bytes_ {bytes} {}
+
+			template<typename T>
+			requires std::is_trivially_copyable_v<T>
+			bool read(T& value) noexcept {
+				return read(&value, sizeof(T));
+			}
+
+			bool read(void* dst, std::size_t size) noexcept {
+				if (bytes_.size() - pos_ < size) {
+					return false;
+				}
+				std::memcpy(dst, bytes_.data() + pos_, size);
+				pos_ += size;
+				return true;
+			}
+
+			bool exhausted() const noexcept { return pos_ == bytes_.size(); }
+			std::size_t remaining() const noexcept { return bytes_.size() - pos_; }
+
+			//count records of at least recordSize bytes each may still be there, check before allocating for them
+			bool mayHold(std::uint64_t count, std::size_t recordSize) const noexcept {
+				return recordSize == 0u ? count <= remaining() : count <= remaining() / recordSize;
+			}
+
+		private:
+			std::span<std::byte const> bytes_;
+			std::size_t pos_ {0u};
+		};
+
+		template<typename T>
+		requires std::is_trivially_copyable_v<T>
+		void snapshotWrite(std::string& out, T const& value) {
+			out.append(reinterpret_cast<char const*>(&value), sizeof(T));
+		}
+
+		class MappedFile {
+		public:
+			explicit MappedFile(char const* path) noexcept {
+				int const fd {::open(path, O_RDONLY)};
+				if (fd < 0) {
+					return;
+				}
+				struct stat st {};
+				if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+					void* addr {::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0)};
+					if (addr != MAP_FAILED) {
+						data_ = addr;
+						size_ = static_cast<std::size_t>(st.st_size);
+						::madvise(data_, size_, MADV_SEQUENTIAL);
+					}
+				}
+				::close(fd);
+			}
+
+			MappedFile(MappedFile const&) = delete;
+			MappedFile& operator=(MappedFile const&) = delete;
+
+			~MappedFile() {
+				if (data_ != nullptr) {
+					::munmap(data_, size_);
+				}
+			}
+
+			bool valid() const noexcept { return data_ != nullptr; }
+
+			std::span<std::byte const> bytes() const noexcept {
+				return {static_cast<std::byte const*>(data_), size_};
+			}
+
+		private:
+			void* data_ {nullptr};
+			std::size_t size_ {0u};
+		};
+
+	}//!namespace details
+
+
+	/**
+	 * @dev
+	 * Opt-in for raw encoding of a class type, i.e. a struct of doubles.
+	 * Specializing it to true is a promise the type has no padding and no pointers,
+	 * since its bytes go as is into a file or to another process.
+	 *
+	 **/
+	template<typename T>
+	inline constexpr bool enable_raw_codec_v {false};
+
+	namespace details {
+
+		//long double is arithmetic, but carries padding on x86;
+		//has_unique_object_representations can't see a pointer member, so class types opt in
+		template<typename T>
+		inline constexpr bool rawEncodable {
+			std::is_trivially_copyable_v<T> && !std::is_same_v<std::remove_cv_t<T>, long double> &&
+			(std::is_arithmetic_v<T> || std::is_enum_v<T> || enable_raw_codec_v<T>)
+		};
+
+	}//!namespace details
+
+	/**
+	 * @dev
+	 * How an Event is put into the image. Arithmetic and enum Events, and types opted in
+	 * by enable_raw_codec_v, are copied as is, strings are length prefixed.
+	 * Specialize for any other Event type, there is no codec for it otherwise.
+	 * A specialization may declare minSize, the least number of bytes an encoded Event takes,
+	 * it lets a reader reject a bogus count before allocating for it.
+	 * read() must never trust a length it has read, check it against SnapshotReader::remaining().
+	 *
+	 **/
+	template<typename Event>
+	struct SnapshotCodec;
+
+	template<typename Event>
+	requires details::rawEncodable<Event>
+	struct SnapshotCodec<Event> {
+		static constexpr std::size_t minSize {sizeof(Event)};
+
+		static void write(std::string& out, Event const& event) {
+			details::snapshotWrite(out, event);
+		}
+		static bool read(details::SnapshotReader& in, Event& event) noexcept {
+			return in.read(event);
+		}
+	};
+
+	template<typename Char, typename Traits, typename Alloc>
+	requires details::rawEncodable<Char>
+	struct SnapshotCodec<std::basic_string<Char, Traits, Alloc>> {
+		static constexpr std::size_t minSize {sizeof(std::uint32_t)};
+
+		static void write(std::string& out, std::basic_string<Char, Traits, Alloc> const& event) {
+			details::snapshotWrite(out, static_cast<std::uint32_t>(event.size()));
+			out.append(reinterpret_cast<char const*>(event.data()), event.size() * sizeof(Char));
+		}
+		static bool read(details::SnapshotReader& in, std::basic_string<Char, Traits, Alloc>& event) {
+			std::uint32_t size {0u};
+			if (!in.read(size) || !in.mayHold(size, sizeof(Char))) {
+				return false;
+			}
+			event.resize(size);
+			return in.read(event.data(), size * sizeof(Char));
+		}
+	};
+
+
+	namespace details {
+
+		template<typename Codec>
+		constexpr std::size_t codecMinSize() noexcept {
+			if constexpr (requires { Codec::minSize; }) {
+				return Codec::minSize;
+			}
+			else {
+				return 0u;
+			}
+		}
+
+	}//!namespace details
+
+
+	template<typename Event, typename Value, typename Hash, typename Equal, std::size_t InlineObservers>
+	class TopologySnapshot<Publisher<Event, Value, Hash, Equal, InlineObservers>> {
+	public:
+
+		using PublisherType = Publisher<Event, Value, Hash, Equal, InlineObservers>;
+		using ObserverType = typename PublisherType::ObserverType;
+
+		static constexpr char magic[8] {'P', 'B', 'O', 'B', 'S', 'N', 'A', 'P'};
+		static constexpr std::uint32_t version {1u};
+		static constexpr std::uint32_t endiannessTag {0x01020304u};
+
+		//least sizes of records, counts read from the image are checked against them before reserve
+		static constexpr std::size_t observerRecordSize {2u * sizeof(std::uint64_t)};
+		static constexpr std::size_t subscriberRecordSize {sizeof(std::int32_t) + sizeof(std::uint32_t)};
+		static constexpr std::size_t eventRecordSize {details::codecMinSize<SnapshotCodec<Event>>() + sizeof(std::uint32_t)};
+
+		//IdOf: std::uint64_t(ObserverType const*)
+		template<typename IdOf>
+		requires std::is_invocable_r_v<std::uint64_t, IdOf, ObserverType const*>
+		static std::string serialize(PublisherType const& publisher, IdOf&& idOf) {
+			std::unordered_map<ObserverType const*, std::uint32_t> observerIndex;
+			std::vector<std::pair<std::uint64_t, std::uint64_t>> observerTable;
+			std::size_t subscriptions {0u};
+			for (auto const& [event, relevantObservers] : publisher.events_) {
+				for (auto const& [niceValue, observerPtr] : relevantObservers) {
+					auto [found, inserted] = observerIndex.emplace(observerPtr, static_cast<std::uint32_t>(observerTable.size()));
+					if (inserted) {
+						observerTable.emplace_back(idOf(observerPtr), 0u);
+					}
+					++observerTable[found->second].second;
+					++subscriptions;
+				}
+			}
+
+			std::string out;
+			out.reserve(sizeof(magic) + 24u + observerTable.size() * 16u +
+			            publisher.events_.size() * (sizeof(Event) + 4u) + subscriptions * 8u);
+			out.append(magic, sizeof(magic));
+			details::snapshotWrite(out, version);
+			details::snapshotWrite(out, endiannessTag);
+			details::snapshotWrite(out, static_cast<std::uint64_t>(observerTable.size()));
+			details::snapshotWrite(out, static_cast<std::uint64_t>(publisher.events_.size()));
+			for (auto const& [id, count] : observerTable) {
+				details::snapshotWrite(out, id);
+				details::snapshotWrite(out, count);
+			}
+			for (auto const& [event, relevantObservers] : publisher.events_) {
+				SnapshotCodec<Event>::write(out, event);
+				details::snapshotWrite(out, static_cast<std::uint32_t>(relevantObservers.size()));
+				for (auto const& [niceValue, observerPtr] : relevantObservers) {
+					details::snapshotWrite(out, static_cast<std::int32_t>(niceValue));
+					details::snapshotWrite(out, observerIndex.find(observerPtr)->second);
+				}
+			}
+			return out;
+		}
+
+		//ObserverOf: ObserverType*(std::uint64_t), nullptr for unknown id fails the load
+		//Existing topology of the publisher is replaced, publisher is left untouched on any failure
+		template<typename ObserverOf>
+		requires std::is_invocable_r_v<ObserverType*, ObserverOf, std::uint64_t>
+		static SnapshotStatus deserialize(std::span<std::byte const> bytes, PublisherType& publisher, ObserverOf&& observerOf) {
+			details::SnapshotReader in {bytes};
+
+			char fileMagic[sizeof(magic)] {};
+			std::uint32_t fileVersion {0u}, fileEndianness {0u};
+			std::uint64_t observerCount {0u}, eventCount {0u};
+			if (!in.read(fileMagic, sizeof(fileMagic))) {
+				return SnapshotStatus::Truncated;
+			}
+			if (std::memcmp(fileMagic, magic, sizeof(magic)) != 0) {
+				return SnapshotStatus::BadMagic;
+			}
+			if (!in.read(fileVersion) || !in.read(fileEndianness)) {
+				return SnapshotStatus::Truncated;
+			}
+			if (fileVersion != version || fileEndianness != endiannessTag) {
+				return SnapshotStatus::BadVersion;
+			}
+			if (!in.read(observerCount) || !in.read(eventCount) ||
+			    !in.mayHold(observerCount, observerRecordSize) ||
+			    !in.mayHold(eventCount, eventRecordSize) ||
+			    observerCount * observerRecordSize + eventCount * eventRecordSize > in.remaining()) {
+				return SnapshotStatus::Truncated;
+			}
+
+			decltype(publisher.observers) observers;
+			//reverse index entry is resolved once per observer, not per subscription
+			using Subscriptions = typename decltype(publisher.observers)::mapped_type;
+			std::vector<std::pair<ObserverType*, Subscriptions*>> observerTable;
+			observerTable.reserve(observerCount);
+			observers.reserve(observerCount);
+			for (std::uint64_t i = 0; i != observerCount; ++i) {
+				std::uint64_t id {0u}, count {0u};
+				//every subscription of the observer is a subscriber record further on
+				if (!in.read(id) || !in.read(count) || !in.mayHold(count, subscriberRecordSize)) {
+					return SnapshotStatus::Truncated;
+				}
+				ObserverType* observer {observerOf(id)};
+				if (observer == nullptr) {
+					return SnapshotStatus::UnknownObserver;
+				}
+				Subscriptions& subscriptions {observers[observer]};
+				subscriptions.reserve(count);
+				observerTable.emplace_back(observer, &subscriptions);
+			}
+
+			decltype(publisher.events_) events;
+			events.reserve(eventCount);
+			for (std::uint64_t i = 0; i != eventCount; ++i) {
+				Event event {};
+				std::uint32_t size {0u};
+				if (!SnapshotCodec<Event>::read(in, event) || !in.read(size) || !in.mayHold(size, subscriberRecordSize)) {
+					return SnapshotStatus::Truncated;
+				}
+				typename PublisherType::Subscribers relevantObservers;
+				relevantObservers.reserve(size);
+				for (std::uint32_t j = 0; j != size; ++j) {
+					std::int32_t niceValue {0};
+					std::uint32_t index {0u};
+					if (!in.read(niceValue) || !in.read(index)) {
+						return SnapshotStatus::Truncated;
+					}
+					if (index >= observerTable.size()) {
+						return SnapshotStatus::UnknownObserver;
+					}
+					auto const [observer, subscriptions] {observerTable[index]};
+					relevantObservers.emplace_back(niceValue, observer);
+					subscriptions->emplace(event);
+				}
+				//a repeated event would leave its subscriptions in the reverse index only
+				if (!events.emplace(std::move(event), std::move(relevantObservers)).second) {
+					return SnapshotStatus::Corrupt;
+				}
+			}
+			if (!in.exhausted()) {
+				return SnapshotStatus::Truncated;
+			}
+
+			publisher.events_ = std::move(events);
+			publisher.observers = std::move(observers);
+			for (auto const& [event, relevantObservers] : publisher.events_) {
+				for (auto const& [niceValue, observerPtr] : relevantObservers) {
+					observerPtr->bookEvent(event);
+				}
+			}
+			return SnapshotStatus::Ok;
+		}
+
+		template<typename IdOf>
+		static SnapshotStatus save(char const* path, PublisherType const& publisher, IdOf&& idOf) {
+			std::string const image {serialize(publisher, std::forward<IdOf>(idOf))};
+			int const fd {::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+			if (fd < 0) {
+				return SnapshotStatus::IoError;
+			}
+			std::size_t written {0u};
+			while (written != image.size()) {
+				ssize_t const res {::write(fd, image.data() + written, image.size() - written)};
+				if (res <= 0) {
+					::close(fd);
+					return SnapshotStatus::IoError;
+				}
+				written += static_cast<std::size_t>(res);
+			}
+			return ::close(fd) == 0 ? SnapshotStatus::Ok : SnapshotStatus::IoError;
+		}
+
+		template<typename ObserverOf>
+		static SnapshotStatus load(char const* path, PublisherType& publisher, ObserverOf&& observerOf) {
+			details::MappedFile const file {path};
+			if (!file.valid()) {
+				return SnapshotStatus::IoError;
+			}
+			return deserialize(file.bytes(), publisher, std::forward<ObserverOf>(observerOf));
+		}
+	};
+
+
+	//deduce base Publisher from whatever is derived from it
+	template<typename Event, typename Value, typename Hash, typename Equal, std::size_t InlineObservers, typename IdOf>
+	SnapshotStatus saveTopology(char const* path, Publisher<Event, Value, Hash, Equal, InlineObservers> const& publisher, IdOf&& idOf) {
+		return TopologySnapshot<Publisher<Event, Value, Hash, Equal, InlineObservers>>::save(path, publisher, std::forward<IdOf>(idOf));
+	}
+
+	template<typename Event, typename Value, typename Hash, typename Equal, std::size_t InlineObservers, typename ObserverOf>
+	SnapshotStatus loadTopology(char const* path, Publisher<Event, Value, Hash, Equal, InlineObservers>& publisher, ObserverOf&& observerOf) {
+		return TopologySnapshot<Publisher<Event, Value, Hash, Equal, InlineObservers>>::load(path, publisher, std::forward<ObserverOf>(observerOf));
+	}
+
+} //!namespace
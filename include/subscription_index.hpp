@@ -0,0 +1,488 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include "observer.hpp"
+#include "snapshot.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace culib::patterns {
+
+	namespace details {
+
+		/**
+		 * @dev
+		 * Counting Bloom filter over hashes, two probes out of one hash.
+		 * No false negatives, so "no" means there is definitely nothing there.
+		 * Counters saturate, saturated counter is never decremented, that keeps it correct.
+		 * With n keys and m counters false positive rate is about (1 - e^(-2n/m))^2,
+		 * i.e. 1.4% at m = 16n, and close to 100% once n gets near m.
+		 *
+		 **/
+		class CountingBloomFilter {
+		public:
+			explicit CountingBloomFilter(std::size_t counters = (1u << 14u))
+				: counters_ (std::bit_ceil(std::max<std::size_t>(counters, 2u)), 0u)
+				, mask_ {counters_.size() - 1u}
+			{}
+
+			void add(std::size_t hash) noexcept {
+				auto const [a, b] = probes(hash);
+				increment(a);
+				increment(b);
+			}
+
+			void remove(std::size_t hash) noexcept {
+				auto const [a, b] = probes(hash);
+				decrement(a);
+				decrement(b);
+			}
+
+			bool mayContain(std::size_t hash) const noexcept {
+				auto const [a, b] = probes(hash);
+				return counters_[a] != 0u && counters_[b] != 0u;
+			}
+
+			std::size_t counters() const noexcept { return counters_.size(); }
+
+		private:
+			static constexpr std::uint16_t saturated {std::numeric_limits<std::uint16_t>::max()};
+			std::vector<std::uint16_t> counters_;
+			std::size_t mask_;
+
+			std::pair<std::size_t, std::size_t> probes(std::size_t hash) const noexcept {
+				//std::hash of integers is identity, so mix before taking bits
+				std::uint64_t h {static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull};
+				h ^= h >> 29u;
+				return {static_cast<std::size_t>(h) & mask_, static_cast<std::size_t>(h >> 32u) & mask_};
+			}
+
+			void increment(std::size_t i) noexcept {
+				if (counters_[i] != saturated) {
+					++counters_[i];
+				}
+			}
+
+			void decrement(std::size_t i) noexcept {
+				if (counters_[i] != saturated && counters_[i] != 0u) {
+					--counters_[i];
+				}
+			}
+		};
+
+		/**
+		 * @dev
+		 * Dense bit matrix, a row per event id, a column per observer id.
+		 * Rows are contiguous, so OR of several rows is a plain loop over words,
+		 * that compiler vectorizes. Width grows by whole words, when an observer id doesn't fit.
+		 *
+		 **/
+		class SubscriptionBitmap {
+		public:
+			using Word = std::uint64_t;
+			static constexpr std::size_t wordBits {64u};
+
+			bool test(std::uint32_t row, std::uint32_t column) const noexcept {
+				if (row >= rows_ || column >= width_ * wordBits) {
+					return false;
+				}
+				return (bits_[row * width_ + column / wordBits] >> (column % wordBits)) & 1u;
+			}
+
+			void set(std::uint32_t row, std::uint32_t column) {
+				fit(row, column);
+				bits_[row * width_ + column / wordBits] |= Word{1u} << (column % wordBits);
+			}
+
+			void reset(std::uint32_t row, std::uint32_t column) noexcept {
+				if (row < rows_ && column < width_ * wordBits) {
+					bits_[row * width_ + column / wordBits] &= ~(Word{1u} << (column % wordBits));
+				}
+			}
+
+			void resetRow(std::uint32_t row) noexcept {
+				if (row < rows_) {
+					std::fill_n(bits_.begin() + static_cast<std::ptrdiff_t>(row * width_), width_, Word{0u});
+				}
+			}
+
+			void orRow(std::uint32_t row, std::vector<Word>& acc) const {
+				acc.resize(width_, Word{0u});
+				if (row >= rows_) {
+					return;
+				}
+				Word const* src {bits_.data() + row * width_};
+				Word* dst {acc.data()};
+				for (std::size_t i = 0; i != width_; ++i) {
+					dst[i] |= src[i];
+				}
+			}
+
+			std::size_t width() const noexcept { return width_; }
+
+		private:
+			std::vector<Word> bits_;
+			std::size_t rows_ {0u};
+			std::size_t width_ {1u};
+
+			void fit(std::uint32_t row, std::uint32_t column) {
+				if (column >= width_ * wordBits) {
+					std::size_t width {width_};
+					while (column >= width * wordBits) {
+						width *= 2u;
+					}
+					std::vector<Word> bits(rows_ * width, Word{0u});
+					for (std::size_t r = 0; r != rows_; ++r) {
+						std::copy_n(bits_.begin() + static_cast<std::ptrdiff_t>(r * width_), width_,
+						            bits.begin() + static_cast<std::ptrdiff_t>(r * width));
+					}
+					bits_ = std::move(bits);
+					width_ = width;
+				}
+				if (row >= rows_) {
+					rows_ = std::max<std::size_t>(row + 1u, rows_ * 2u);
+					bits_.resize(rows_ * width_, Word{0u});
+				}
+			}
+		};
+
+	}//!namespace details
+
+
+	/**
+	 * @dev
+	 * Publisher with a subscription index: observers and events are numbered densely,
+	 * subscriptions are bits of a matrix, and events that have any subscriber are
+	 * put into a counting Bloom filter.
+	 * Publish to an event nobody listens to is rejected by the filter without touching
+	 * the registry, and observersOnAny() answers "who is on any of these events" by OR of the rows.
+	 * Dense ids are handed out as EventId by addEvent() and as ObserverId by Attach(),
+	 * with them hasSubscription is a bit test and pushUpdate does no hashing at all.
+	 * EventId is valid while the event exists, ObserverId while the observer has
+	 * any subscription; both are recycled afterwards.
+	 * Price is one extra hash of Event on the publish by Event, so it pays off when
+	 * a good share of publishes have no subscribers; otherwise use plain Publisher.
+	 * Filter keeps at least countersPerEvent counters per event with subscribers, that is
+	 * about 1.4% false positives; it is doubled and refilled from the index when more events
+	 * get subscribers, so it doesn't degrade into "maybe" for everything. Pass the expected
+	 * number of such events to the constructor to avoid the regrowth, memory is 2 bytes a counter.
+	 *
+	 **/
+	template<typename Event, typename Value, typename Hash = std::hash<Event>, typename Equal = std::equal_to<Event>,
+	         std::size_t InlineObservers = 4u>
+	class IndexedPublisher : public Publisher<Event, Value, Hash, Equal, InlineObservers> {
+	public:
+
+		using PublisherBase = Publisher<Event, Value, Hash, Equal, InlineObservers>;
+		using ObserverType = typename PublisherBase::ObserverType;
+
+		static constexpr std::uint32_t invalidId {std::numeric_limits<std::uint32_t>::max()};
+		static constexpr std::size_t countersPerEvent {16u};
+
+		explicit IndexedPublisher(std::size_t expectedSubscribedEvents = 1024u)
+			: bloom_ {expectedSubscribedEvents * countersPerEvent}
+		{}
+
+		struct EventId {
+			std::uint32_t value {invalidId};
+			bool valid() const noexcept { return value != invalidId; }
+			bool operator==(EventId const&) const noexcept = default;
+		};
+
+		struct ObserverId {
+			std::uint32_t value {invalidId};
+			bool valid() const noexcept { return value != invalidId; }
+			bool operator==(ObserverId const&) const noexcept = default;
+		};
+
+		//returns id of the observer, invalid if it ends up with no subscription
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		ObserverId Attach(ObserverType *observer, int niceValue, Events const&... events) &
+		{
+			(IndexedAttachImpl(observer, niceValue, events), ...);
+			return observerId(observer);
+		}
+
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		void Detach(ObserverType *observer, Events const&... events) &
+		{
+			(IndexedDetachImpl(observer, events), ...);
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		ObserverId Attach(ObserverType *observer, int niceValue, Container const& events) &
+		{
+			for (auto const& event : events) {
+				IndexedAttachImpl(observer, niceValue, event);
+			}
+			return observerId(observer);
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		void Detach(ObserverType *observer, Container const& events) &
+		{
+			for (auto const& event : events) {
+				IndexedDetachImpl(observer, event);
+			}
+		}
+
+		void pushUpdate(Event const& event, Value const& newValue) const & {
+			if (!bloom_.mayContain(Hash{}(event))) {
+				return;
+			}
+			PublisherBase::pushUpdate(event, newValue);
+		}
+
+		void pushUpdate(EventId id, Value const& newValue) const & {
+			if (id.value >= eventsById_.size() || eventsById_[id.value] == nullptr) {
+				return;
+			}
+			auto const& [event, relevantObservers] {*eventsById_[id.value]};
+			for (auto [niceValue, observerPtr] : relevantObservers) {
+				observerPtr->updateCallback(event, newValue);
+			}
+		}
+
+		//id of an existing event is returned as is
+		EventId addEvent (Event const& event) & {
+			if (auto foundEvent = eventIds_.find(event); foundEvent != eventIds_.end()) {
+				return EventId{foundEvent->second};
+			}
+			PublisherBase::addEvent(event);
+			std::uint32_t const id {nextEventId()};
+			eventIds_.emplace(event, id);
+			eventsById_[id] = &*this->events_.find(event);
+			return EventId{id};
+		}
+
+		void removeEvent (Event const& event) & {
+			auto foundEvent = eventIds_.find(event);
+			if (foundEvent == eventIds_.end()) {
+				return;
+			}
+			auto const& relevantObservers {this->getObservers(event)};
+			if (!relevantObservers.empty()) {
+				bloomRemove(event);
+			}
+			for (auto [niceValue, observerPtr] : relevantObservers) {
+				releaseObserverId(observerPtr);
+			}
+			bitmap_.resetRow(foundEvent->second);
+			eventsById_[foundEvent->second] = nullptr;
+			freeEventIds_.push_back(foundEvent->second);
+			eventIds_.erase(foundEvent);
+			PublisherBase::removeEvent(event);
+		}
+
+		EventId eventId(Event const& event) const & noexcept {
+			auto foundEvent = eventIds_.find(event);
+			return foundEvent == eventIds_.end() ? EventId{} : EventId{foundEvent->second};
+		}
+
+		ObserverId observerId(ObserverType *observer) const & noexcept {
+			auto foundObserver = observerIds_.find(observer);
+			return foundObserver == observerIds_.end() ? ObserverId{} : ObserverId{foundObserver->second};
+		}
+
+		bool hasSubscription(ObserverId observer, EventId event) const & noexcept {
+			return bitmap_.test(event.value, observer.value);
+		}
+
+		bool hasSubscription(ObserverType *observer, Event const& event) const & noexcept {
+			return hasSubscription(observerId(observer), eventId(event));
+		}
+
+		//true means "maybe", false means there is definitely no subscriber
+		bool mayHaveSubscribers(Event const& event) const & noexcept {
+			return bloom_.mayContain(Hash{}(event));
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		std::vector<ObserverType*> observersOnAny(Container const& events) const & {
+			std::vector<details::SubscriptionBitmap::Word> acc(bitmap_.width(), 0u);
+			for (auto const& event : events) {
+				if (auto foundEvent = eventIds_.find(event); foundEvent != eventIds_.end()) {
+					bitmap_.orRow(foundEvent->second, acc);
+				}
+			}
+			std::vector<ObserverType*> result;
+			for (std::size_t w = 0; w != acc.size(); ++w) {
+				for (auto word {acc[w]}; word != 0u; word &= word - 1u) {
+					std::size_t const column {w * details::SubscriptionBitmap::wordBits + static_cast<std::size_t>(std::countr_zero(word))};
+					result.push_back(observersById_[column]);
+				}
+			}
+			return result;
+		}
+
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		std::vector<ObserverType*> observersOnAny(Events const&... events) const & {
+			return observersOnAny(std::array<Event, sizeof...(Events)>{events...});
+		}
+
+		//index is derived from the base registry, call it when the registry was replaced behind it, i.e. by loadTopology
+		void rebuildIndex() & {
+			eventIds_.clear();
+			eventsById_.clear();
+			freeEventIds_.clear();
+			observerIds_.clear();
+			observersById_.clear();
+			freeObserverIds_.clear();
+			subscriptionsById_.clear();
+			bitmap_ = details::SubscriptionBitmap{};
+			subscribedEvents_ = 0u;
+			for (auto& entry : this->events_) {
+				std::uint32_t const id {nextEventId()};
+				eventIds_.emplace(entry.first, id);
+				eventsById_[id] = &entry;
+				subscribedEvents_ += entry.second.empty() ? 0u : 1u;
+				for (auto [niceValue, observerPtr] : entry.second) {
+					std::uint32_t const observerId {observerIdOf(observerPtr)};
+					bitmap_.set(id, observerId);
+					++subscriptionsById_[observerId];
+				}
+			}
+			refillBloom(std::max(bloom_.counters(), subscribedEvents_ * countersPerEvent));
+		}
+
+		std::size_t bloomCounters() const & noexcept {
+			return bloom_.counters();
+		}
+
+	protected:
+		using EventEntry = std::pair<Event const, typename PublisherBase::Subscribers>;
+
+		std::unordered_map<Event, std::uint32_t, Hash, Equal> eventIds_;
+		//node of the base registry, stable until the event is removed
+		std::vector<EventEntry const*> eventsById_;
+		std::vector<std::uint32_t> freeEventIds_;
+		std::unordered_map<ObserverType*, std::uint32_t> observerIds_;
+		std::vector<ObserverType*> observersById_;
+		std::vector<std::uint32_t> freeObserverIds_;
+		std::vector<std::uint32_t> subscriptionsById_;
+		details::SubscriptionBitmap bitmap_;
+		details::CountingBloomFilter bloom_;
+		std::size_t subscribedEvents_ {0u};
+
+		void IndexedAttachImpl(ObserverType *observer, int niceValue, Event const& event) {
+			auto foundEvent = eventIds_.find(event);
+			if (foundEvent == eventIds_.end()) {
+				//todo must be logged, no event
+				return;
+			}
+			//base is the source of truth, index follows only what it has actually booked
+			std::size_t const before {this->getObservers(event).size()};
+			PublisherBase::AttachImpl(observer, niceValue, event);
+			if (this->getObservers(event).size() == before) {
+				return;
+			}
+			std::uint32_t const observerId {observerIdOf(observer)};
+			bitmap_.set(foundEvent->second, observerId);
+			++subscriptionsById_[observerId];
+			if (before == 0u) {
+				bloomAdd(event);
+			}
+		}
+
+		void IndexedDetachImpl(ObserverType *observer, Event const& event) {
+			bool const subscribed {hasSubscription(observer, event)};
+			PublisherBase::DetachImpl(observer, event);
+			if (!subscribed) {
+				return;
+			}
+			std::uint32_t const observerId {observerIds_.find(observer)->second};
+			bitmap_.reset(eventIds_.find(event)->second, observerId);
+			if (this->getObservers(event).empty()) {
+				bloomRemove(event);
+			}
+			releaseObserverId(observer);
+		}
+
+		void bloomAdd(Event const& event) {
+			if (++subscribedEvents_ * countersPerEvent > bloom_.counters()) {
+				//refill puts this event in as well, its subscriber is booked already
+				refillBloom(bloom_.counters() * 2u);
+				return;
+			}
+			bloom_.add(Hash{}(event));
+		}
+
+		void bloomRemove(Event const& event) noexcept {
+			--subscribedEvents_;
+			bloom_.remove(Hash{}(event));
+		}
+
+		void refillBloom(std::size_t counters) {
+			bloom_ = details::CountingBloomFilter{counters};
+			for (EventEntry const* entry : eventsById_) {
+				if (entry != nullptr && !entry->second.empty()) {
+					bloom_.add(Hash{}(entry->first));
+				}
+			}
+		}
+
+		std::uint32_t nextEventId() {
+			if (freeEventIds_.empty()) {
+				eventsById_.push_back(nullptr);
+				return static_cast<std::uint32_t>(eventsById_.size() - 1u);
+			}
+			std::uint32_t const id {freeEventIds_.back()};
+			freeEventIds_.pop_back();
+			return id;
+		}
+
+		void releaseObserverId(ObserverType *observer) {
+			auto foundObserver = observerIds_.find(observer);
+			std::uint32_t const observerId {foundObserver->second};
+			if (--subscriptionsById_[observerId] == 0u) {
+				//recycle the column, so ids stay dense
+				observerIds_.erase(foundObserver);
+				observersById_[observerId] = nullptr;
+				freeObserverIds_.push_back(observerId);
+			}
+		}
+
+		std::uint32_t observerIdOf(ObserverType *observer) {
+			auto [found, inserted] = observerIds_.emplace(observer, 0u);
+			if (inserted) {
+				if (freeObserverIds_.empty()) {
+					found->second = static_cast<std::uint32_t>(observersById_.size());
+					observersById_.push_back(observer);
+					subscriptionsById_.push_back(0u);
+				}
+				else {
+					found->second = freeObserverIds_.back();
+					freeObserverIds_.pop_back();
+					observersById_[found->second] = observer;
+				}
+			}
+			return found->second;
+		}
+	};
+
+
+	//loading replaces the base registry, so the index is rebuilt after it
+	template<typename Event, typename Value, typename Hash, typename Equal, std::size_t InlineObservers, typename ObserverOf>
+	SnapshotStatus loadTopology(char const* path, IndexedPublisher<Event, Value, Hash, Equal, InlineObservers>& publisher, ObserverOf&& observerOf) {
+		SnapshotStatus const status {TopologySnapshot<Publisher<Event, Value, Hash, Equal, InlineObservers>>::load(
+				path, publisher, std::forward<ObserverOf>(observerOf))};
+		if (status == SnapshotStatus::Ok) {
+			publisher.rebuildIndex();
+		}
+		return status;
+	}
+
+} //!namespace
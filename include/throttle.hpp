@@ -0,0 +1,305 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include "observer.hpp"
+#include "gated_publisher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace culib::patterns {
+
+	/**
+	 * @dev
+	 * Per subscription delivery policy. All the modes keep the latest skipped value
+	 * and deliver it as a trailing update, once the policy allows, so the Observer
+	 * always ends up with the last state of the Publisher.
+	 * MaxRate     - at most perSecond deliveries on average, bursts up to burst are let through.
+	 * MinInterval - at least interval between two deliveries, first one is delivered immediately.
+	 * Coalesce    - first update opens a window, only the latest value is delivered when it closes.
+	 *
+	 **/
+	struct Throttle {
+		enum class Mode {
+			MaxRate,
+			MinInterval,
+			Coalesce,
+		};
+
+		Mode mode {Mode::MinInterval};
+		std::chrono::nanoseconds interval {0};
+		std::uint32_t burst {1u};
+
+		//slowest rate, a non-positive or NaN perSecond is clamped to it, so is anything slower
+		static constexpr std::chrono::nanoseconds maxInterval {std::chrono::hours{24}};
+
+		static Throttle maxRate(double perSecond, std::uint32_t burst = 1u) noexcept {
+			std::chrono::duration<double> const seconds {maxInterval};
+			std::chrono::nanoseconds const interval {
+				perSecond > 0.0 && 1.0 / perSecond < seconds.count()
+					? std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / perSecond))
+					: maxInterval
+			};
+			//burst x interval is a span of ticks, keep it far from overflow
+			std::uint64_t const maxBurst {interval.count() == 0 ? std::uint64_t{std::numeric_limits<std::uint32_t>::max()}
+				: static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max() / 4 / interval.count())};
+			burst = static_cast<std::uint32_t>(std::clamp<std::uint64_t>(burst, 1u, maxBurst));
+			return Throttle{Mode::MaxRate, interval, burst};
+		}
+
+		static Throttle minInterval(std::chrono::nanoseconds interval) noexcept {
+			return Throttle{Mode::MinInterval, interval, 1u};
+		}
+
+		static Throttle coalesce(std::chrono::nanoseconds window) noexcept {
+			return Throttle{Mode::Coalesce, window, 1u};
+		}
+	};
+
+	namespace details {
+
+		struct TimerNode {
+			TimerNode* timerNext {nullptr};
+			TimerNode* timerPrev {nullptr};
+			std::int64_t timerDeadline {0};
+			bool timerScheduled {false};
+		};
+
+		/**
+		 * @dev
+		 * Hashed timer wheel, intrusive, no allocation on schedule or cancel.
+		 * Node is expected to be derived from TimerNode and have fire(std::int64_t nowTick).
+		 * Deadlines beyond one revolution stay in their slot and are skipped until due.
+		 *
+		 **/
+		template<typename Node, std::size_t Slots = 256u>
+		requires ((Slots & (Slots - 1u)) == 0u)
+		class TimerWheel {
+		public:
+			explicit TimerWheel(std::int64_t nowTick) noexcept : current_ {nowTick} {}
+
+			TimerWheel(TimerWheel const&) = delete;
+			TimerWheel& operator=(TimerWheel const&) = delete;
+
+			void schedule(Node* node, std::int64_t deadlineTick) noexcept {
+				cancel(node);
+				TimerNode* timer {node};
+				timer->timerDeadline = deadlineTick > current_ ? deadlineTick : current_ + 1;
+				TimerNode*& head {slots_[static_cast<std::size_t>(timer->timerDeadline) & mask]};
+				timer->timerPrev = nullptr;
+				timer->timerNext = head;
+				if (head != nullptr) {
+					head->timerPrev = timer;
+				}
+				head = timer;
+				timer->timerScheduled = true;
+			}
+
+			void cancel(Node* node) noexcept {
+				TimerNode* timer {node};
+				if (!timer->timerScheduled) {
+					return;
+				}
+				if (timer->timerPrev != nullptr) {
+					timer->timerPrev->timerNext = timer->timerNext;
+				}
+				else {
+					slots_[static_cast<std::size_t>(timer->timerDeadline) & mask] = timer->timerNext;
+				}
+				if (timer->timerNext != nullptr) {
+					timer->timerNext->timerPrev = timer->timerPrev;
+				}
+				timer->timerNext = timer->timerPrev = nullptr;
+				timer->timerScheduled = false;
+			}
+
+			//returns number of fired nodes
+			std::size_t advance(std::int64_t nowTick) {
+				if (nowTick <= current_) {
+					return 0u;
+				}
+				std::uint64_t const steps {std::min<std::uint64_t>(static_cast<std::uint64_t>(nowTick - current_), Slots)};
+				TimerNode* due {nullptr};
+				for (std::uint64_t i = 1; i <= steps; ++i) {
+					TimerNode* timer {slots_[static_cast<std::size_t>(current_ + static_cast<std::int64_t>(i)) & mask]};
+					while (timer != nullptr) {
+						TimerNode* next {timer->timerNext};
+						if (timer->timerDeadline <= nowTick) {
+							cancel(static_cast<Node*>(timer));
+							timer->timerNext = due;
+							due = timer;
+						}
+						timer = next;
+					}
+				}
+				current_ = nowTick;
+
+				//fire after the walk, node may reschedule itself
+				std::size_t fired {0u};
+				while (due != nullptr) {
+					TimerNode* next {due->timerNext};
+					due->timerNext = nullptr;
+					static_cast<Node*>(due)->fire(nowTick);
+					due = next;
+					++fired;
+				}
+				return fired;
+			}
+
+			std::int64_t current() const noexcept { return current_; }
+
+		private:
+			static constexpr std::size_t mask {Slots - 1u};
+			std::array<TimerNode*, Slots> slots_ {};
+			std::int64_t current_;
+		};
+
+	}//!namespace details
+
+
+	/**
+	 * @dev
+	 * Publisher that accepts Throttle on Attach. Throttled subscription is served by a gate,
+	 * an Observer that stands between Publisher and target Observer, so pushUpdate path of
+	 * non-throttled subscriptions is untouched. Skipped update costs a value copy into the gate,
+	 * trailing values are flushed by the timer wheel, that must be driven by advance(),
+	 * i.e. from the same loop that calls pushUpdate.
+	 * Clock must be a std::chrono clock, it is a parameter for the sake of tests.
+	 *
+	 **/
+	template<typename Event, typename Value, typename Clock = std::chrono::steady_clock,
+	         typename Hash = std::hash<Event>, typename Equal = std::equal_to<Event>>
+	class ThrottledPublisher : public details::GatedPublisher<Event, Value, Hash, Equal> {
+	public:
+
+		using GatedBase = details::GatedPublisher<Event, Value, Hash, Equal>;
+		using PublisherBase = typename GatedBase::PublisherBase;
+		using ObserverType = typename PublisherBase::ObserverType;
+		using clock_type = Clock;
+
+		explicit ThrottledPublisher(std::chrono::nanoseconds tick = std::chrono::milliseconds(1))
+			: tick_ {tick.count() > 0 ? tick.count() : 1}
+			, wheel_ {nowNs() / tick_}
+		{}
+
+		using GatedBase::Attach;
+
+		template<typename... Events>
+		requires ::culib::requirements::AllTheSame<Event, Events...>
+		void Attach(ObserverType *observer, int niceValue, Throttle const& throttle, Events const&... events) &
+		{
+			(AttachThrottledImpl(observer, niceValue, throttle, events), ...);
+		}
+
+		template<::culib::requirements::IsContainer Container>
+		requires std::same_as<typename Container::value_type, Event>
+		void Attach(ObserverType *observer, int niceValue, Throttle const& throttle, Container const& events) &
+		{
+			for (auto const& event : events) {
+				AttachThrottledImpl(observer, niceValue, throttle, event);
+			}
+		}
+
+		//flushes trailing values that are due, returns number of them
+		std::size_t advance() & {
+			return wheel_.advance(nowNs() / tick_);
+		}
+
+	private:
+
+		class Gate final : public details::Gate<Event, Value>, public details::TimerNode {
+		public:
+			Gate(ThrottledPublisher& owner, ObserverType* target, Event const& event, Throttle const& throttle)
+				: details::Gate<Event, Value>(target, event), owner_ {owner}, throttle_ {throttle}
+			{}
+
+			void updateCallback(Event const& event, Value const& value) & override {
+				std::int64_t const now {ThrottledPublisher::nowNs()};
+				if (throttle_.mode == Throttle::Mode::Coalesce) {
+					pending_ = value;
+					if (!timerScheduled) {
+						owner_.schedule(this, now + throttle_.interval.count());
+					}
+					return;
+				}
+				if (now >= nextAllowed()) {
+					//due already, a pending value is superseded, no need to wait for advance()
+					if (pending_) {
+						owner_.wheel_.cancel(this);
+						pending_.reset();
+					}
+					deliver(event, value, now);
+					return;
+				}
+				//latest wins
+				pending_ = value;
+				if (!timerScheduled) {
+					owner_.schedule(this, nextAllowed());
+				}
+			}
+
+			void fire([[maybe_unused]] std::int64_t nowTick) {
+				if (!pending_) {
+					return;
+				}
+				std::int64_t const now {ThrottledPublisher::nowNs()};
+				if (throttle_.mode != Throttle::Mode::Coalesce && now < nextAllowed()) {
+					//tick granularity, due time is not reached yet
+					owner_.schedule(this, nextAllowed());
+					return;
+				}
+				Value value {std::move(*pending_)};
+				pending_.reset();
+				deliver(this->event_, value, now);
+			}
+
+		private:
+			ThrottledPublisher& owner_;
+			Throttle throttle_;
+			//theoretical arrival time of GCRA, that is a token bucket kept in one integer
+			std::int64_t tat_ {std::numeric_limits<std::int64_t>::min() / 2};
+			std::optional<Value> pending_;
+
+			std::int64_t nextAllowed() const noexcept {
+				return tat_ - static_cast<std::int64_t>(throttle_.burst - 1u) * throttle_.interval.count();
+			}
+
+			void deliver(Event const& event, Value const& value, std::int64_t now) {
+				tat_ = std::max(tat_, now) + throttle_.interval.count();
+				this->target_->updateCallback(event, value);
+			}
+		};
+
+		std::int64_t tick_;
+		details::TimerWheel<Gate> wheel_;
+
+		static std::int64_t nowNs() noexcept {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+		}
+
+		void schedule(Gate* gate, std::int64_t deadlineNs) noexcept {
+			//round up, trailing value is never delivered early
+			wheel_.schedule(gate, (deadlineNs + tick_ - 1) / tick_);
+		}
+
+		void AttachThrottledImpl(ObserverType *observer, int niceValue, Throttle const& throttle, Event const& event) {
+			this->AttachGatedImpl(observer, niceValue, event, [&] {
+				return std::make_unique<Gate>(*this, observer, event, throttle);
+			});
+		}
+
+		void onGateDetached(typename GatedBase::GateType& gate) override {
+			wheel_.cancel(static_cast<Gate*>(&gate));
+		}
+	};
+
+} //!namespace
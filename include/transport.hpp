@@ -0,0 +1,404 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#pragma once
+
+#include "observer.hpp"
+#include "snapshot.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace culib::patterns {
+
+	/**
+	 * @dev
+	 * Unix domain stream socket, owns the descriptor.
+	 * Failure to create a socket results in an invalid one, check valid().
+	 *
+	 **/
+	class LocalSocket {
+	public:
+		LocalSocket() noexcept = default;
+		explicit LocalSocket(int fd) noexcept : fd_ {fd} {}
+
+		LocalSocket(LocalSocket const&) = delete;
+		LocalSocket& operator=(LocalSocket const&) = delete;
+
+		LocalSocket(LocalSocket&& other) noexcept : fd_ {std::exchange(other.fd_, -1)} {}
+		LocalSocket& operator=(LocalSocket&& other) noexcept {
+			if (this != &other) {
+				close();
+				fd_ = std::exchange(other.fd_, -1);
+			}
+			return *this;
+		}
+
+		~LocalSocket() {
+			close();
+		}
+
+		static std::pair<LocalSocket, LocalSocket> pair() noexcept {
+			int fds[2] {-1, -1};
+			if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+				return {};
+			}
+			return {LocalSocket{fds[0]}, LocalSocket{fds[1]}};
+		}
+
+		static LocalSocket listen(std::string const& path, int backlog = 16) noexcept {
+			sockaddr_un addr {};
+			if (!address(path, addr)) {
+				return {};
+			}
+			LocalSocket socket {::socket(AF_UNIX, SOCK_STREAM, 0)};
+			::unlink(path.c_str());
+			if (!socket.valid() ||
+			    ::bind(socket.fd_, reinterpret_cast<sockaddr const*>(&addr), sizeof(addr)) != 0 ||
+			    ::listen(socket.fd_, backlog) != 0) {
+				return {};
+			}
+			return socket;
+		}
+
+		static LocalSocket connect(std::string const& path) noexcept {
+			sockaddr_un addr {};
+			if (!address(path, addr)) {
+				return {};
+			}
+			LocalSocket socket {::socket(AF_UNIX, SOCK_STREAM, 0)};
+			if (!socket.valid() || ::connect(socket.fd_, reinterpret_cast<sockaddr const*>(&addr), sizeof(addr)) != 0) {
+				return {};
+			}
+			return socket;
+		}
+
+		LocalSocket accept() const noexcept {
+			return LocalSocket{::accept(fd_, nullptr, nullptr)};
+		}
+
+		bool valid() const noexcept { return fd_ >= 0; }
+		int fd() const noexcept { return fd_; }
+
+		void close() noexcept {
+			if (fd_ >= 0) {
+				::close(fd_);
+				fd_ = -1;
+			}
+		}
+
+	private:
+		int fd_ {-1};
+
+		static bool address(std::string const& path, sockaddr_un& addr) noexcept {
+			if (path.size() >= sizeof(addr.sun_path)) {
+				return false;
+			}
+			addr.sun_family = AF_UNIX;
+			std::memcpy(addr.sun_path, path.c_str(), path.size() + 1u);
+			return true;
+		}
+	};
+
+
+	/**
+	 * @dev
+	 * Publisher side of an out of process Observer. Attach it as any other Observer,
+	 * every delivery is encoded as a frame: u32 payload length, then Event and Value
+	 * encoded by Codec, same pluggable encoding as topology snapshot uses.
+	 * Frames are accumulated into a batch and sent by a single sendmsg, when the batch
+	 * exceeds maxBatchBytes, or on flush(). With maxBatchBytes == 0 and Event and Value
+	 * that SnapshotCodec copies as is, the frame is sent right from the arguments, with no copy at all.
+	 * Bytes go to another process, so a type with padding or pointers needs its own Codec.
+	 * Sending never blocks the publishing thread: what the socket doesn't take is kept
+	 * in a backlog and goes first on the next send or flush(). A consumer that lets the
+	 * backlog grow over maxBacklogBytes is considered stalled and is disconnected,
+	 * so it sees the end of stream rather than a torn frame.
+	 * That, or a failed send, breaks the proxy, it drops everything afterwards, see broken().
+	 * Backlog still pending on destruction is lost.
+	 *
+	 **/
+	template<typename Event, typename Value, template<typename> typename Codec = SnapshotCodec>
+	class RemoteObserver final : public Observer<Event, Value> {
+	public:
+
+		using frame_size_type = std::uint32_t;
+
+		explicit RemoteObserver(LocalSocket socket, std::size_t maxBatchBytes = 64u * 1024u,
+		                        std::size_t maxBacklogBytes = 4u * 1024u * 1024u)
+			: socket_ {std::move(socket)}
+			, maxBatchBytes_ {maxBatchBytes}
+			, maxBacklogBytes_ {maxBacklogBytes}
+		{
+			batch_.reserve(maxBatchBytes_ + 256u);
+		}
+
+		~RemoteObserver() override {
+			flush();
+		}
+
+		void updateCallback(Event const& event, Value const& value) & override {
+			if (broken_) {
+				return;
+			}
+			if constexpr (zeroCopy) {
+				if (maxBatchBytes_ == 0u) {
+					frame_size_type const size {sizeof(Event) + sizeof(Value)};
+					iovec iov[3] {
+						{const_cast<frame_size_type*>(&size), sizeof(size)},
+						{const_cast<Event*>(&event), sizeof(Event)},
+						{const_cast<Value*>(&value), sizeof(Value)},
+					};
+					send(iov, 3u);
+					++frames_;
+					return;
+				}
+			}
+			std::size_t const header {batch_.size()};
+			batch_.append(sizeof(frame_size_type), '\0');
+			Codec<Event>::write(batch_, event);
+			Codec<Value>::write(batch_, value);
+			frame_size_type const size {static_cast<frame_size_type>(batch_.size() - header - sizeof(frame_size_type))};
+			std::memcpy(batch_.data() + header, &size, sizeof(size));
+			++frames_;
+			if (batch_.size() >= maxBatchBytes_) {
+				flush();
+			}
+		}
+
+		//sends the batch, or whatever is left in the backlog
+		void flush() & {
+			if (broken_) {
+				return;
+			}
+			if (batch_.empty()) {
+				drainBacklog();
+				return;
+			}
+			iovec iov {batch_.data(), batch_.size()};
+			send(&iov, 1u);
+			batch_.clear();
+		}
+
+		bool broken() const noexcept { return broken_; }
+		std::size_t frames() const noexcept { return frames_; }
+		//bytes the socket hasn't taken yet
+		std::size_t pending() const noexcept { return backlog_.size() - backlogHead_; }
+
+	private:
+		static constexpr bool zeroCopy {
+			std::is_same_v<Codec<Event>, SnapshotCodec<Event>> && details::rawEncodable<Event> &&
+			std::is_same_v<Codec<Value>, SnapshotCodec<Value>> && details::rawEncodable<Value>
+		};
+
+		LocalSocket socket_;
+		std::size_t maxBatchBytes_;
+		std::size_t maxBacklogBytes_;
+		std::string batch_;
+		std::string backlog_;
+		std::size_t backlogHead_ {0u};
+		std::size_t frames_ {0u};
+		bool broken_ {false};
+
+		void send(iovec* iov, std::size_t count) {
+			//nothing may overtake the backlog
+			if (!drainBacklog()) {
+				keep(iov, count);
+				return;
+			}
+			while (count != 0u) {
+				std::size_t sent {sendSome(iov, count)};
+				if (sent == 0u) {
+					break;
+				}
+				//partial send, skip what is gone
+				while (count != 0u && sent >= iov->iov_len) {
+					sent -= iov->iov_len;
+					++iov;
+					--count;
+				}
+				if (count != 0u) {
+					iov->iov_base = static_cast<char*>(iov->iov_base) + sent;
+					iov->iov_len -= sent;
+				}
+			}
+			keep(iov, count);
+		}
+
+		//false if the socket is full or gone
+		bool drainBacklog() {
+			while (!broken_ && backlogHead_ != backlog_.size()) {
+				iovec iov {backlog_.data() + backlogHead_, backlog_.size() - backlogHead_};
+				std::size_t const sent {sendSome(&iov, 1u)};
+				if (sent == 0u) {
+					return false;
+				}
+				backlogHead_ += sent;
+			}
+			backlog_.clear();
+			backlogHead_ = 0u;
+			return !broken_;
+		}
+
+		//bytes sent, 0 if the socket is full; any other error breaks the proxy
+		std::size_t sendSome(iovec* iov, std::size_t count) {
+			msghdr msg {};
+			msg.msg_iov = iov;
+			msg.msg_iovlen = count;
+			while (true) {
+				ssize_t const sent {::sendmsg(socket_.fd(), &msg, MSG_NOSIGNAL | MSG_DONTWAIT)};
+				if (sent >= 0) {
+					return static_cast<std::size_t>(sent);
+				}
+				if (errno == EINTR) {
+					continue;
+				}
+				if (errno != EAGAIN && errno != EWOULDBLOCK) {
+					disconnect();
+				}
+				return 0u;
+			}
+		}
+
+		void keep(iovec const* iov, std::size_t count) {
+			if (broken_) {
+				return;
+			}
+			if (backlogHead_ > backlog_.size() / 2u) {
+				backlog_.erase(0u, backlogHead_);
+				backlogHead_ = 0u;
+			}
+			for (std::size_t i = 0; i != count; ++i) {
+				backlog_.append(static_cast<char const*>(iov[i].iov_base), iov[i].iov_len);
+			}
+			if (pending() > maxBacklogBytes_) {
+				//stalled consumer, cut it off rather than grow without limit or block the publisher
+				disconnect();
+			}
+		}
+
+		void disconnect() noexcept {
+			broken_ = true;
+			socket_.close();
+			backlog_.clear();
+			backlogHead_ = 0u;
+		}
+	};
+
+
+	/**
+	 * @dev
+	 * Receiving side: reads frames sent by RemoteObserver and drives a local Observer.
+	 * receive() does one read of whatever is there and dispatches every complete frame,
+	 * so a batch is unpacked by a single system call.
+	 * Peer is not trusted: a frame announcing more than maxFrameBytes, or one Codec can't
+	 * decode within the frame, is malformed, and the connection is dropped.
+	 * So the buffer never holds more than maxFrameBytes plus a read chunk; it is kept
+	 * between calls and grows only, so an empty poll costs just the recv.
+	 *
+	 **/
+	template<typename Event, typename Value, template<typename> typename Codec = SnapshotCodec>
+	class RemoteObserverAdapter {
+	public:
+
+		using ObserverType = Observer<Event, Value>;
+		using frame_size_type = std::uint32_t;
+
+		RemoteObserverAdapter(LocalSocket socket, ObserverType* target, std::size_t readChunk = 64u * 1024u,
+		                      std::size_t maxFrameBytes = 1024u * 1024u)
+			: socket_ {std::move(socket)}
+			, target_ {target}
+			, readChunk_ {readChunk}
+			, maxFrameBytes_ {maxFrameBytes}
+		{}
+
+		//returns number of dispatched frames, wait == false doesn't block if there is nothing to read
+		std::size_t receive(bool wait = true) & {
+			if (!connected_) {
+				return 0u;
+			}
+			//buffer only grows, and only when a partial frame is longer than a chunk
+			if (buffer_.size() - filled_ < readChunk_) {
+				buffer_.resize(filled_ + readChunk_);
+			}
+			ssize_t received;
+			do {
+				received = ::recv(socket_.fd(), buffer_.data() + filled_, buffer_.size() - filled_, wait ? 0 : MSG_DONTWAIT);
+			} while (received < 0 && errno == EINTR);
+
+			if (received <= 0) {
+				if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+					connected_ = false;
+				}
+				return 0u;
+			}
+			filled_ += static_cast<std::size_t>(received);
+			return dispatch();
+		}
+
+		bool connected() const noexcept { return connected_; }
+		bool malformed() const noexcept { return malformed_; }
+
+	private:
+		LocalSocket socket_;
+		ObserverType* target_;
+		std::size_t readChunk_;
+		std::size_t maxFrameBytes_;
+		std::vector<std::byte> buffer_;
+		std::size_t filled_ {0u};
+		bool connected_ {true};
+		bool malformed_ {false};
+
+		std::size_t dispatch() {
+			std::size_t pos {0u}, frames {0u};
+			while (filled_ - pos >= sizeof(frame_size_type)) {
+				frame_size_type size {0u};
+				std::memcpy(&size, buffer_.data() + pos, sizeof(size));
+				if (size > maxFrameBytes_) {
+					disconnectMalformed();
+					return frames;
+				}
+				if (filled_ - pos - sizeof(size) < size) {
+					break;
+				}
+				//codecs check every length they read against what is left of the frame
+				details::SnapshotReader in {std::span<std::byte const>{buffer_.data() + pos + sizeof(size), size}};
+				Event event {};
+				Value value {};
+				if (!Codec<Event>::read(in, event) || !Codec<Value>::read(in, value) || !in.exhausted()) {
+					disconnectMalformed();
+					return frames;
+				}
+				target_->updateCallback(event, value);
+				pos += sizeof(size) + size;
+				++frames;
+			}
+			//partial frame goes to the front, it is at most maxFrameBytes
+			if (pos != 0u) {
+				std::memmove(buffer_.data(), buffer_.data() + pos, filled_ - pos);
+				filled_ -= pos;
+			}
+			return frames;
+		}
+
+		//stream can't be trusted past a bad frame
+		void disconnectMalformed() noexcept {
+			malformed_ = true;
+			connected_ = false;
+			socket_.close();
+			buffer_.clear();
+			filled_ = 0u;
+		}
+	};
+
+} //!namespace
@@ -0,0 +1,139 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "include/merge.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+    struct Tick {
+        std::int64_t ts {0};
+        int venue {0};
+    };
+
+    using Event = std::string;
+
+    struct RecordingObserver final : public culib::patterns::Observer<Event, Tick> {
+        std::vector<Tick> received;
+
+        void updateCallback(Event const&, Tick const& value) & override {
+            received.push_back(value);
+        }
+    };
+
+    auto const keyOf = [](Event const&, Tick const& t) { return t.ts; };
+
+    int const niceValue {10};
+
+}//!namespace
+
+
+TEST(OrderedFanIn, MergesInGlobalOrder) {
+    RecordingObserver o;
+    auto fanIn {culib::patterns::makeOrderedFanIn(static_cast<culib::patterns::Observer<Event, Tick>*>(&o), keyOf, std::int64_t{1'000}, 2u)};
+    culib::patterns::Publisher<Event, Tick> venueA, venueB;
+    venueA.addEvent("px");
+    venueB.addEvent("px");
+    venueA.Attach(fanIn->source(0), niceValue, Event{"px"});
+    venueB.Attach(fanIn->source(1), niceValue, Event{"px"});
+
+    venueA.pushUpdate("px", Tick{10, 0});
+    venueA.pushUpdate("px", Tick{30, 0});
+    ASSERT_EQ(fanIn->drain(), 0u);
+
+    venueB.pushUpdate("px", Tick{20, 1});
+    ASSERT_EQ(fanIn->drain(), 2u);
+    ASSERT_EQ(o.received[0].ts, 10);
+    ASSERT_EQ(o.received[1].ts, 20);
+
+    venueB.pushUpdate("px", Tick{40, 1});
+    ASSERT_EQ(fanIn->drain(), 1u);
+    ASSERT_EQ(o.received[2].ts, 30);
+
+    //venue A is idle, B is far ahead, window lets 40 go
+    venueB.pushUpdate("px", Tick{2'000, 1});
+    ASSERT_EQ(fanIn->drain(), 1u);
+    ASSERT_EQ(o.received[3].ts, 40);
+
+    venueA.pushUpdate("px", Tick{35, 0});
+    fanIn->drain();
+    ASSERT_EQ(fanIn->late(), 1u);
+}
+
+TEST(OrderedFanIn, ConcurrentSourcesStayOrdered) {
+    RecordingObserver o;
+    std::size_t const sources {4u};
+    std::int64_t const perSource {20'000};
+    auto fanIn {culib::patterns::makeOrderedFanIn(static_cast<culib::patterns::Observer<Event, Tick>*>(&o),
+                                                  keyOf, std::numeric_limits<std::int64_t>::max(), sources, 256u)};
+    std::vector<culib::patterns::Publisher<Event, Tick>> venues(sources);
+    for (std::size_t i = 0; i != sources; ++i) {
+        venues[i].addEvent("px");
+        venues[i].Attach(fanIn->source(i), niceValue, Event{"px"});
+    }
+
+    std::vector<std::thread> producers;
+    for (std::size_t i = 0; i != sources; ++i) {
+        producers.emplace_back([&venues, i, sources, perSource] {
+            for (std::int64_t k = 0; k != perSource; ++k) {
+                venues[i].pushUpdate("px", Tick{k * static_cast<std::int64_t>(sources) + static_cast<std::int64_t>(i), static_cast<int>(i)});
+            }
+            //closing tick, lets the others drain completely
+            venues[i].pushUpdate("px", Tick{std::numeric_limits<std::int64_t>::max(), static_cast<int>(i)});
+        });
+    }
+
+    std::size_t const expected {sources * static_cast<std::size_t>(perSource)};
+    while (o.received.size() < expected) {
+        fanIn->drain(64u);
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    bool ordered {true};
+    for (std::size_t i = 0; i != expected; ++i) {
+        ordered = ordered && o.received[i].ts == static_cast<std::int64_t>(i);
+    }
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(fanIn->late(), 0u);
+}
+
+TEST(OrderedFanIn, WindowNearKeyLimits) {
+    RecordingObserver o;
+    auto fanIn {culib::patterns::makeOrderedFanIn(static_cast<culib::patterns::Observer<Event, Tick>*>(&o), keyOf, std::int64_t{1'000}, 3u)};
+    std::vector<culib::patterns::Publisher<Event, Tick>> venues(3u);
+    for (std::size_t i = 0; i != venues.size(); ++i) {
+        venues[i].addEvent("px");
+        venues[i].Attach(fanIn->source(i), niceValue, Event{"px"});
+    }
+
+    //third venue is silent: the lowest key is far behind the newest, the highest one is not
+    venues[0].pushUpdate("px", Tick{std::numeric_limits<std::int64_t>::min() + 10, 0});
+    venues[1].pushUpdate("px", Tick{std::numeric_limits<std::int64_t>::max() - 10, 1});
+    ASSERT_EQ(fanIn->drain(), 1u);
+    ASSERT_EQ(o.received[0].venue, 0);
+}
+
+TEST(OrderedFanIn, FullQueueDropsOnSameThread) {
+    using FanIn = culib::patterns::OrderedFanIn<Event, Tick, std::decay_t<decltype(keyOf)>>;
+    RecordingObserver o;
+    auto fanIn {culib::patterns::makeOrderedFanIn(static_cast<culib::patterns::Observer<Event, Tick>*>(&o), keyOf,
+                                                  std::int64_t{0}, 1u, 4u, FanIn::FullQueue::Drop)};
+    culib::patterns::Publisher<Event, Tick> venue;
+    venue.addEvent("px");
+    venue.Attach(fanIn->source(0), niceValue, Event{"px"});
+
+    for (std::int64_t k = 0; k != 10; ++k) {
+        venue.pushUpdate("px", Tick{k, 0});
+    }
+    ASSERT_EQ(fanIn->drain(), 4u);
+    ASSERT_EQ(fanIn->dropped(), 6u);
+    ASSERT_EQ(o.received.back().ts, 3);
+}
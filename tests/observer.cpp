@@ -180,3 +180,92 @@ TYPED_TEST(BasicsPatternsObserver, NiceValues_Remove) {
     ASSERT_EQ(observers3.size(), 1u);
     ASSERT_EQ(observers3[0], std::pair(niceValue, &o1));
 }
+
+
+namespace {
+
+    enum class Side {
+        Bid,
+        Ask,
+        Count
+    };
+
+    using Quotes = culib::patterns::EventSet<"bid", "ask", "last">;
+
+    template <typename Event>
+    struct ClosedSetObserver final : public culib::patterns::Observer<Event, Value> {
+
+        std::size_t calls {0u};
+        Value lastValue {0.0};
+
+        void updateCallback([[maybe_unused]] Event const& event, Value const& value) & override {
+            ++calls;
+            lastValue = value;
+        }
+    };
+
+    static_assert(culib::requirements::is_closed_event_set_v<Side>);
+    static_assert(culib::requirements::is_closed_event_set_v<Quotes>);
+    static_assert(!culib::requirements::is_closed_event_set_v<int>);
+    static_assert(culib::patterns::Publisher<Side, Value>::event_count == 2u);
+    static_assert(culib::patterns::Publisher<Quotes, Value>::event_count == 3u);
+    static_assert(Quotes{"last"}.index() == 2u);
+
+}//!namespace
+
+
+TEST(ClosedEventSetPublisher, EnumAttachAndPush) {
+    ClosedSetObserver<Side> o;
+    culib::patterns::Publisher<Side, Value> p;
+
+    p.Attach(&o, niceValue, Side::Bid);
+    ASSERT_FALSE(p.hasSubscription(&o, Side::Bid));
+
+    p.addEvent(Side::Bid);
+    p.Attach(&o, niceValue, Side::Bid);
+    ASSERT_TRUE(p.hasSubscription(&o, Side::Bid));
+    ASSERT_FALSE(p.hasSubscription(&o, Side::Ask));
+
+    p.pushUpdate(Side::Bid, 1.0);
+    p.template pushUpdate<Side::Bid>(2.0);
+    p.template pushUpdate<Side::Ask>(3.0);
+    ASSERT_EQ(o.calls, 2u);
+    ASSERT_EQ(o.lastValue, 2.0);
+
+    p.pushUpdate(static_cast<Side>(42), 4.0);
+    ASSERT_EQ(o.calls, 2u);
+}
+
+TEST(ClosedEventSetPublisher, FixedStringNiceValues) {
+    ClosedSetObserver<Quotes> o1, o2, o3;
+    culib::patterns::Publisher<Quotes, Value> p;
+
+    p.addEvent("ask");
+    p.Attach(&o1, niceValue, Quotes{"ask"});
+    p.Attach(&o2, niceValue - 5, Quotes{"ask"});
+    p.Attach(&o3, niceValue, Quotes{"ask"});
+
+    auto const& observers {p.getObservers("ask")};
+    ASSERT_EQ(observers.size(), 3u);
+    ASSERT_EQ(observers[0].second, &o2);
+    ASSERT_EQ(observers[1].second, &o1);
+    ASSERT_EQ(observers[2].second, &o3);
+
+    p.template pushUpdate<Quotes{"ask"}>(5.0);
+    ASSERT_EQ(o1.calls + o2.calls + o3.calls, 3u);
+
+    p.Detach(&o2, Quotes{"ask"});
+    ASSERT_FALSE(p.hasSubscription(&o2, "ask"));
+    ASSERT_EQ(p.getObservers("ask").size(), 2u);
+
+    ASSERT_FALSE(Quotes::fromName("mid").valid());
+    p.pushUpdate(Quotes::fromName("mid"), 6.0);
+    p.pushUpdate(Quotes::fromName("ask"), 7.0);
+    ASSERT_EQ(o1.lastValue, 7.0);
+    ASSERT_EQ(o2.lastValue, 5.0);
+
+    p.removeEvent("ask");
+    ASSERT_FALSE(p.eventExists("ask"));
+    ASSERT_FALSE(p.hasSubscription(&o1, "ask"));
+    ASSERT_TRUE(p.getObservers("ask").empty());
+}
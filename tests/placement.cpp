@@ -0,0 +1,127 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "include/placement.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+    using Event = std::string;
+    using Value = double;
+
+    struct ThreadRecordingObserver final : public culib::patterns::Observer<Event, Value> {
+        std::vector<Value> received;
+        std::thread::id thread;
+
+        void updateCallback(Event const&, Value const& value) & override {
+            received.push_back(value);
+            thread = std::this_thread::get_id();
+        }
+    };
+
+    struct CountingObserver final : public culib::patterns::Observer<Event, Value> {
+        std::atomic<std::size_t> calls {0u};
+        std::atomic<Value> last {0.0};
+
+        void updateCallback(Event const&, Value const& value) & override {
+            last.store(value);
+            calls.fetch_add(1u);
+        }
+    };
+
+    int const niceValue {10};
+
+}//!namespace
+
+
+TEST(PlacedPublisher, DeliversOnWorkerThread) {
+    culib::patterns::PlacedPublisher<Event, Value> p;
+    ThreadRecordingObserver placed, plain;
+    p.addEvent("px");
+    p.Attach(&placed, niceValue, culib::patterns::Placement::onCore(0), Event{"px"});
+    p.Attach(&plain, niceValue, Event{"px"});
+    ASSERT_TRUE(p.hasSubscription(&placed, "px"));
+    ASSERT_TRUE(p.hasSubscription(&plain, "px"));
+
+    for (int i = 0; i != 1000; ++i) {
+        p.pushUpdate("px", i);
+    }
+    p.drain();
+
+    ASSERT_EQ(placed.received.size(), 1000u);
+    ASSERT_EQ(placed.received.back(), 999.0);
+    ASSERT_NE(placed.thread, std::this_thread::get_id());
+    ASSERT_EQ(plain.thread, std::this_thread::get_id());
+
+    p.Detach(&placed, Event{"px"});
+    ASSERT_FALSE(p.hasSubscription(&placed, "px"));
+    p.pushUpdate("px", 1.0);
+    p.drain();
+    ASSERT_EQ(placed.received.size(), 1000u);
+}
+
+TEST(PlacedPublisher, CrossNodeDeliveriesFlushedPerPublish) {
+    culib::patterns::PlacedPublisher<Event, Value> p {1024u, 64u};
+    std::vector<CountingObserver> remotes(3u);
+    p.addEvent("px");
+    //node other than home one, whether it exists or not, placement is best effort
+    int const otherNode {p.homeNode() + 1};
+    for (auto& remote : remotes) {
+        p.Attach(&remote, niceValue, culib::patterns::Placement::onNode(otherNode), Event{"px"});
+    }
+
+    //one publish is one batch for the worker, far below crossNodeBatch, and still nothing is stuck
+    p.pushUpdate("px", 1.0);
+    auto const deadline {std::chrono::steady_clock::now() + std::chrono::seconds(10)};
+    auto const delivered = [&remotes] {
+        return std::all_of(remotes.begin(), remotes.end(), [](auto const& r) { return r.calls.load() == 1u; });
+    };
+    while (!delivered() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    ASSERT_TRUE(delivered());
+
+    p.pushUpdate("px", 2.0);
+    p.pushUpdate("px", 3.0);
+    p.Detach(&remotes[0], Event{"px"});
+    ASSERT_EQ(remotes[0].calls.load(), 3u);
+    ASSERT_EQ(remotes[0].last.load(), 3.0);
+    p.pushUpdate("px", 4.0);
+    p.drain();
+    ASSERT_EQ(remotes[0].calls.load(), 3u);
+    ASSERT_EQ(remotes[2].calls.load(), 4u);
+    ASSERT_EQ(remotes[2].last.load(), 4.0);
+}
+
+TEST(PlacedPublisher, ParkedWorkerWakesOnPush) {
+    //parks as soon as the inbox is empty
+    culib::patterns::PlacedPublisher<Event, Value> p {1024u, 64u, 0u};
+    CountingObserver local, remote;
+    p.addEvent("px");
+    p.Attach(&local, niceValue, culib::patterns::Placement::onCore(0), Event{"px"});
+    p.Attach(&remote, niceValue, culib::patterns::Placement::onNode(p.homeNode() + 1), Event{"px"});
+
+    for (int i = 1; i <= 100; ++i) {
+        if (i % 10 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        p.pushUpdate("px", i);
+    }
+    auto const deadline {std::chrono::steady_clock::now() + std::chrono::seconds(10)};
+    auto const delivered = [&] { return local.calls.load() == 100u && remote.calls.load() == 100u; };
+    while (!delivered() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    ASSERT_TRUE(delivered());
+    ASSERT_EQ(local.last.load(), 100.0);
+    ASSERT_EQ(remote.last.load(), 100.0);
+}
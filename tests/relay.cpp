@@ -0,0 +1,102 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "include/relay.hpp"
+
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    using Event = std::string;
+    using Value = double;
+
+    struct RecordingObserver final : public culib::patterns::Observer<Event, Value> {
+
+        std::vector<std::pair<Event, Value>> received;
+
+        void updateCallback(Event const& event, Value const& value) & override {
+            received.emplace_back(event, value);
+        }
+    };
+
+    int const niceValue {10};
+
+}//!namespace
+
+
+TEST(Relay, FusedChainIsCalledInOrder) {
+    std::vector<int> order;
+    auto chain = culib::patterns::fuse(
+            [&order](Event const& e, Value v, auto&& emit) { order.push_back(1); emit(e, v + 1.0); },
+            [&order](Event const& e, Value v, auto&& emit) { order.push_back(2); emit(e + "_x2", v * 2.0); },
+            [&order](Event const& e, Value v, auto&& emit) { order.push_back(3); if (v > 0.0) emit(e, v); }
+    );
+
+    std::vector<std::pair<Event, Value>> out;
+    chain(Event{"px"}, 1.0, [&out](Event const& e, Value v) { out.emplace_back(e, v); });
+    chain(Event{"px"}, -5.0, [&out](Event const& e, Value v) { out.emplace_back(e, v); });
+
+    ASSERT_EQ(order, (std::vector<int>{1, 2, 3, 1, 2, 3}));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_EQ(out[0], std::pair(Event{"px_x2"}, 4.0));
+}
+
+TEST(Relay, FanOutDag) {
+    auto dag = culib::patterns::fuse(
+            [](Event const& e, Value v, auto&& emit) { emit(e, v * 10.0); },
+            culib::patterns::fanOut(
+                    [](Event const& e, Value v, auto&& emit) { emit(e + "_a", v); },
+                    culib::patterns::fuse(
+                            [](Event const& e, Value v, auto&& emit) { emit(e + "_b", v + 1.0); },
+                            [](Event const& e, Value v, auto&& emit) { emit(e, -v); }
+                    )
+            )
+    );
+
+    std::vector<std::pair<Event, Value>> out;
+    dag(Event{"e"}, 1.0, [&out](Event const& e, Value v) { out.emplace_back(e, v); });
+
+    ASSERT_EQ(out.size(), 2u);
+    ASSERT_EQ(out[0], std::pair(Event{"e_a"}, 10.0));
+    ASSERT_EQ(out[1], std::pair(Event{"e_b"}, -11.0));
+}
+
+TEST(Relay, RelayLinksPublishers) {
+    culib::patterns::Publisher<Event, Value> source;
+    auto relay = culib::patterns::makeRelay<Event, Value>(culib::patterns::fuse(
+            [](Event const& e, Value v, auto&& emit) { emit(e, v * 2.0); },
+            [](Event const&, Value v, auto&& emit) { emit(Event{"doubled"}, v); }
+    ));
+    RecordingObserver sink;
+
+    source.addEvent("raw");
+    source.Attach(&relay, niceValue, Event{"raw"});
+    relay.addEvent("doubled");
+    relay.Attach(&sink, niceValue, Event{"doubled"});
+
+    ASSERT_TRUE(source.hasSubscription(&relay, "raw"));
+    ASSERT_TRUE(relay.hasSubscription(&sink, "doubled"));
+
+    source.pushUpdate("raw", 21.0);
+    ASSERT_EQ(sink.received.size(), 1u);
+    ASSERT_EQ(sink.received[0], std::pair(Event{"doubled"}, 42.0));
+
+    relay.removeEvent("doubled");
+    source.pushUpdate("raw", 1.0);
+    ASSERT_EQ(sink.received.size(), 1u);
+}
+
+TEST(Relay, TypesAreCheckedOnBothSides) {
+    using RelayType = culib::patterns::Relay<Event, Value, int, std::string,
+            decltype([](Event const&, Value, auto&&) {})>;
+
+    static_assert(std::is_same_v<RelayType::event_type, int>);
+    static_assert(std::is_same_v<RelayType::value_type, std::string>);
+    static_assert(culib::patterns::checkPublisherObserver<RelayType, culib::patterns::Observer<int, std::string>>());
+    static_assert(culib::patterns::checkPublisherObserver<culib::patterns::Publisher<Event, Value>, RelayType::ObserverBase>());
+    SUCCEED();
+}
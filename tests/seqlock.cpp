@@ -0,0 +1,92 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "include/seqlock.hpp"
+
+#include <string>
+#include <thread>
+
+
+namespace {
+
+    struct Quote {
+        double bid {0.0};
+        double ask {0.0};
+        std::uint64_t id {0u};
+    };
+
+    using Event = std::string;
+
+    static_assert(alignof(culib::patterns::SeqlockSlot<Quote>) == culib::patterns::cacheLineSize);
+
+    int const niceValue {10};
+
+}//!namespace
+
+
+TEST(Seqlock, PollerSeesLatestAndMissed) {
+    culib::patterns::Publisher<Event, Quote> p;
+    culib::patterns::LastValueObserver<Event, Quote> lastValues;
+    p.addEvent("eurusd");
+    p.Attach(&lastValues, niceValue, Event{"eurusd"});
+    lastValues.prepare(Event{"eurusd"});
+    ASSERT_FALSE(lastValues.poller("usdjpy").valid());
+
+    auto poller1 {lastValues.poller("eurusd")};
+    auto poller2 {lastValues.poller("eurusd")};
+    Quote q;
+
+    auto result {poller1.poll(q)};
+    ASSERT_FALSE(result.updated);
+
+    p.pushUpdate("eurusd", Quote{1.0, 2.0, 1u});
+    result = poller1.poll(q);
+    ASSERT_TRUE(result.updated);
+    ASSERT_EQ(result.missed, 0u);
+    ASSERT_EQ(q.id, 1u);
+
+    result = poller1.poll(q);
+    ASSERT_FALSE(result.updated);
+
+    p.pushUpdate("eurusd", Quote{1.1, 2.1, 2u});
+    p.pushUpdate("eurusd", Quote{1.2, 2.2, 3u});
+    p.pushUpdate("eurusd", Quote{1.3, 2.3, 4u});
+    result = poller1.poll(q);
+    ASSERT_TRUE(result.updated);
+    ASSERT_EQ(result.missed, 2u);
+    ASSERT_EQ(result.sequence, 4u);
+    ASSERT_EQ(q.id, 4u);
+    ASSERT_EQ(q.ask, 2.3);
+
+    result = poller2.poll(q);
+    ASSERT_TRUE(result.updated);
+    ASSERT_EQ(result.missed, 3u);
+}
+
+TEST(Seqlock, NoTornReadsUnderConcurrentWrites) {
+    culib::patterns::SeqlockSlot<Quote> slot;
+    std::uint64_t const writes {200'000u};
+
+    std::thread writer([&slot, writes] {
+        for (std::uint64_t i = 1; i <= writes; ++i) {
+            double const d {static_cast<double>(i)};
+            slot.write(Quote{d, -d, i});
+        }
+    });
+
+    culib::patterns::Poller<Quote> poller {&slot};
+    Quote q;
+    std::uint64_t lastId {0u};
+    bool consistent {true};
+    while (lastId != writes) {
+        if (poller.poll(q).updated) {
+            consistent = consistent && q.bid == static_cast<double>(q.id) && q.ask == -q.bid && q.id > lastId;
+            lastId = q.id;
+        }
+    }
+    writer.join();
+    ASSERT_TRUE(consistent);
+    ASSERT_EQ(slot.sequence(), writes);
+}
@@ -0,0 +1,83 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "include/observer.hpp"
+
+#include <string>
+
+
+namespace {
+
+    using Value = double;
+
+    struct CountingObserver final : public culib::patterns::Observer<int, Value> {
+        std::size_t calls {0u};
+
+        void updateCallback(int const&, Value const&) & override {
+            ++calls;
+        }
+    };
+
+    static_assert(culib::requirements::is_container_v<culib::patterns::SmallVector<int, 2u>>);
+
+}//!namespace
+
+
+TEST(SmallVector, InlineThenHeap) {
+    culib::patterns::SmallVector<std::string, 2u> v;
+    ASSERT_TRUE(v.isInline());
+
+    v.emplace_back("a");
+    v.emplace_back("b");
+    ASSERT_TRUE(v.isInline());
+    ASSERT_EQ(v.capacity(), 2u);
+
+    v.emplace_back("c");
+    ASSERT_FALSE(v.isInline());
+    v.emplace(v.begin(), "z");
+    ASSERT_EQ(v.size(), 4u);
+    ASSERT_EQ(v[0], "z");
+    ASSERT_EQ(v[3], "c");
+
+    v.erase(v.begin() + 1);
+    ASSERT_EQ(v[0], "z");
+    ASSERT_EQ(v[1], "b");
+    ASSERT_EQ(v.size(), 3u);
+
+    auto copy {v};
+    ASSERT_EQ(copy, v);
+    auto moved {std::move(v)};
+    ASSERT_EQ(moved, copy);
+    ASSERT_TRUE(v.empty());
+    ASSERT_TRUE(v.isInline());
+
+    culib::patterns::SmallVector<std::string, 2u> small;
+    small.emplace_back("x");
+    moved = std::move(small);
+    ASSERT_TRUE(moved.isInline());
+    ASSERT_EQ(moved.size(), 1u);
+    ASSERT_EQ(moved[0], "x");
+}
+
+TEST(SmallVector, PublisherOverflowsInlineCapacity) {
+    culib::patterns::Publisher<int, Value, std::hash<int>, std::equal_to<int>, 1u> p;
+    CountingObserver o1, o2, o3;
+
+    p.addEvent(1);
+    p.Attach(&o1, 3, 1);
+    ASSERT_TRUE(p.getObservers(1).isInline());
+    p.Attach(&o2, 1, 1);
+    p.Attach(&o3, 2, 1);
+    ASSERT_FALSE(p.getObservers(1).isInline());
+
+    auto const& observers {p.getObservers(1)};
+    ASSERT_EQ(observers.size(), 3u);
+    ASSERT_EQ(observers[0].second, &o2);
+    ASSERT_EQ(observers[1].second, &o3);
+    ASSERT_EQ(observers[2].second, &o1);
+
+    p.pushUpdate(1, 1.0);
+    ASSERT_EQ(o1.calls + o2.calls + o3.calls, 3u);
+}
@@ -0,0 +1,139 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "include/snapshot.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+
+namespace {
+
+    using event_types = testing::Types<
+        int,
+        std::string
+    >;
+
+    using Value = double;
+
+    template <typename Event>
+    struct IdentifiedObserver final : public culib::patterns::Observer<Event, Value> {
+        std::uint64_t id {0u};
+    };
+
+    template <typename Event>
+    Event makeEvent(int i) {
+        if constexpr (std::is_same_v<Event, std::string>) {
+            return "event_" + std::to_string(i);
+        }
+        else {
+            return i;
+        }
+    }
+
+    template<typename T>
+    class TopologySnapshot : public testing::Test {};
+    TYPED_TEST_SUITE(TopologySnapshot, event_types);
+
+}//!namespace
+
+
+TYPED_TEST(TopologySnapshot, RoundTripFile) {
+    using Event = TypeParam;
+    using PublisherType = culib::patterns::Publisher<Event, Value>;
+    using ObserverType = typename PublisherType::ObserverType;
+
+    std::array<IdentifiedObserver<Event>, 3> original, restored;
+    for (std::size_t i = 0; i != original.size(); ++i) {
+        original[i].id = restored[i].id = 100u + i;
+    }
+
+    PublisherType p;
+    for (int i = 0; i != 5; ++i) {
+        p.addEvent(makeEvent<Event>(i));
+    }
+    p.Attach(&original[0], 10, makeEvent<Event>(0), makeEvent<Event>(1));
+    p.Attach(&original[1], 5, makeEvent<Event>(0), makeEvent<Event>(2));
+    p.Attach(&original[2], 7, makeEvent<Event>(0));
+
+    std::string const path {testing::TempDir() + "topology.bin"};
+    auto const idOf = [](ObserverType const* o) { return static_cast<IdentifiedObserver<Event> const*>(o)->id; };
+    ASSERT_EQ(culib::patterns::saveTopology(path.c_str(), p, idOf), culib::patterns::SnapshotStatus::Ok);
+
+    PublisherType loaded;
+    auto const observerOf = [&restored](std::uint64_t id) -> ObserverType* {
+        return id - 100u < restored.size() ? &restored[id - 100u] : nullptr;
+    };
+    ASSERT_EQ(culib::patterns::loadTopology(path.c_str(), loaded, observerOf), culib::patterns::SnapshotStatus::Ok);
+    std::remove(path.c_str());
+
+    for (int i = 0; i != 5; ++i) {
+        ASSERT_TRUE(loaded.eventExists(makeEvent<Event>(i)));
+    }
+    auto const& observers {loaded.getObservers(makeEvent<Event>(0))};
+    ASSERT_EQ(observers.size(), 3u);
+    ASSERT_EQ(observers[0], std::pair(5, static_cast<ObserverType*>(&restored[1])));
+    ASSERT_EQ(observers[1], std::pair(7, static_cast<ObserverType*>(&restored[2])));
+    ASSERT_EQ(observers[2], std::pair(10, static_cast<ObserverType*>(&restored[0])));
+
+    ASSERT_TRUE(loaded.hasSubscription(&restored[0], makeEvent<Event>(1)));
+    ASSERT_TRUE(loaded.hasSubscription(&restored[1], makeEvent<Event>(2)));
+    ASSERT_FALSE(loaded.hasSubscription(&restored[2], makeEvent<Event>(1)));
+    ASSERT_TRUE(loaded.getObservers(makeEvent<Event>(3)).empty());
+    ASSERT_EQ(restored[0].eventValues.size(), 2u);
+}
+
+TYPED_TEST(TopologySnapshot, CorruptedImageRejected) {
+    using Event = TypeParam;
+    using PublisherType = culib::patterns::Publisher<Event, Value>;
+    using ObserverType = typename PublisherType::ObserverType;
+    using Snapshot = culib::patterns::TopologySnapshot<PublisherType>;
+
+    IdentifiedObserver<Event> o;
+    PublisherType p;
+    p.addEvent(makeEvent<Event>(1));
+    p.Attach(&o, 1, makeEvent<Event>(1));
+
+    std::string image {Snapshot::serialize(p, [](ObserverType const*) { return std::uint64_t{42u}; })};
+    auto const bytes = [](std::string const& s) { return std::as_bytes(std::span{s.data(), s.size()}); };
+    auto const known = [&o](std::uint64_t id) -> ObserverType* { return id == 42u ? &o : nullptr; };
+    auto const unknown = [](std::uint64_t) -> ObserverType* { return nullptr; };
+
+    PublisherType loaded;
+    ASSERT_EQ(Snapshot::deserialize(bytes(image), loaded, unknown), culib::patterns::SnapshotStatus::UnknownObserver);
+    ASSERT_FALSE(loaded.eventExists(makeEvent<Event>(1)));
+
+    std::string const truncated {image.substr(0, image.size() - 1u)};
+    ASSERT_EQ(Snapshot::deserialize(bytes(truncated), loaded, known), culib::patterns::SnapshotStatus::Truncated);
+
+    //counts from a crafted header must not reach an allocation
+    auto const patched = [&image](std::size_t offset, auto value) {
+        std::string crafted {image};
+        std::memcpy(crafted.data() + offset, &value, sizeof(value));
+        return crafted;
+    };
+    std::size_t const header {sizeof(Snapshot::magic) + 8u}, observersAt {header + 16u}, eventsAt {observersAt + 16u};
+    ASSERT_EQ(Snapshot::deserialize(bytes(patched(header, std::uint64_t{1u} << 61u)), loaded, known), culib::patterns::SnapshotStatus::Truncated);
+    ASSERT_EQ(Snapshot::deserialize(bytes(patched(header + 8u, ~std::uint64_t{0u})), loaded, known), culib::patterns::SnapshotStatus::Truncated);
+    ASSERT_EQ(Snapshot::deserialize(bytes(patched(observersAt + 8u, std::uint64_t{1u} << 61u)), loaded, known), culib::patterns::SnapshotStatus::Truncated);
+    if constexpr (std::is_same_v<Event, std::string>) {
+        ASSERT_EQ(Snapshot::deserialize(bytes(patched(eventsAt, std::uint32_t{0xFFFFFFF0u})), loaded, known), culib::patterns::SnapshotStatus::Truncated);
+    }
+    else {
+        ASSERT_EQ(Snapshot::deserialize(bytes(patched(eventsAt + sizeof(Event), std::uint32_t{0xFFFFFFF0u})), loaded, known), culib::patterns::SnapshotStatus::Truncated);
+    }
+    ASSERT_FALSE(loaded.eventExists(makeEvent<Event>(1)));
+
+    //same event record twice
+    std::string duplicated {patched(header + 8u, std::uint64_t{2u}) + image.substr(eventsAt)};
+    ASSERT_EQ(Snapshot::deserialize(bytes(duplicated), loaded, known), culib::patterns::SnapshotStatus::Corrupt);
+    ASSERT_FALSE(loaded.eventExists(makeEvent<Event>(1)));
+
+    image[0] = 'X';
+    ASSERT_EQ(Snapshot::deserialize(bytes(image), loaded, known), culib::patterns::SnapshotStatus::BadMagic);
+    ASSERT_FALSE(loaded.eventExists(makeEvent<Event>(1)));
+}
@@ -0,0 +1,213 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "include/subscription_index.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    using event_types = testing::Types<
+        int,
+        std::string
+    >;
+
+    using Value = double;
+
+    template <typename Event>
+    struct CountingObserver final : public culib::patterns::Observer<Event, Value> {
+        std::size_t calls {0u};
+
+        void updateCallback(Event const&, Value const&) & override {
+            ++calls;
+        }
+    };
+
+    template <typename Event>
+    Event makeEvent(int i) {
+        if constexpr (std::is_same_v<Event, std::string>) {
+            return "event_" + std::to_string(i);
+        }
+        else {
+            return i;
+        }
+    }
+
+    template<typename T>
+    class IndexedPublisher : public testing::Test {};
+    TYPED_TEST_SUITE(IndexedPublisher, event_types);
+
+    int const niceValue {10};
+
+}//!namespace
+
+
+TYPED_TEST(IndexedPublisher, SubscriptionsAndRejection) {
+    using Event = TypeParam;
+    culib::patterns::IndexedPublisher<Event, Value> p;
+    CountingObserver<Event> o1, o2;
+
+    Event const e1 {makeEvent<Event>(1)}, e2 {makeEvent<Event>(2)}, e3 {makeEvent<Event>(3)};
+    p.addEvent(e1);
+    p.addEvent(e2);
+    p.addEvent(e3);
+
+    p.Attach(&o1, niceValue, e1, e2);
+    p.Attach(&o2, niceValue, e2);
+    p.Attach(&o2, niceValue, e2);
+
+    ASSERT_TRUE(p.hasSubscription(&o1, e1));
+    ASSERT_TRUE(p.hasSubscription(&o1, e2));
+    ASSERT_FALSE(p.hasSubscription(&o2, e1));
+    ASSERT_TRUE(p.hasSubscription(&o2, e2));
+    ASSERT_EQ(p.getObservers(e2).size(), 2u);
+    ASSERT_FALSE(p.mayHaveSubscribers(e3));
+
+    p.pushUpdate(e2, 1.0);
+    p.pushUpdate(e3, 1.0);
+    ASSERT_EQ(o1.calls, 1u);
+    ASSERT_EQ(o2.calls, 1u);
+
+    p.Detach(&o1, e1);
+    ASSERT_FALSE(p.hasSubscription(&o1, e1));
+    ASSERT_FALSE(p.mayHaveSubscribers(e1));
+    p.pushUpdate(e1, 1.0);
+    ASSERT_EQ(o1.calls, 1u);
+
+    p.removeEvent(e2);
+    ASSERT_FALSE(p.hasSubscription(&o1, e2));
+    ASSERT_FALSE(p.hasSubscription(&o2, e2));
+    ASSERT_FALSE(p.mayHaveSubscribers(e2));
+}
+
+TYPED_TEST(IndexedPublisher, ObserversOnAny) {
+    using Event = TypeParam;
+    culib::patterns::IndexedPublisher<Event, Value> p;
+    std::vector<CountingObserver<Event>> observers(150);
+
+    for (int i = 0; i != 10; ++i) {
+        p.addEvent(makeEvent<Event>(i));
+    }
+    //observer k is on event k % 10, so there are columns beyond the first word
+    for (std::size_t k = 0; k != observers.size(); ++k) {
+        p.Attach(&observers[k], niceValue, makeEvent<Event>(static_cast<int>(k % 10u)));
+    }
+
+    auto found {p.observersOnAny(makeEvent<Event>(3), makeEvent<Event>(7), makeEvent<Event>(42))};
+    ASSERT_EQ(found.size(), 30u);
+    for (auto* observer : found) {
+        auto const k {static_cast<std::size_t>(static_cast<CountingObserver<Event>*>(observer) - observers.data())};
+        ASSERT_TRUE(k % 10u == 3u || k % 10u == 7u);
+    }
+
+    p.Detach(&observers[3], makeEvent<Event>(3));
+    ASSERT_EQ(p.observersOnAny(makeEvent<Event>(3)).size(), 14u);
+    ASSERT_TRUE(p.hasSubscription(&observers[13], makeEvent<Event>(3)));
+    ASSERT_TRUE(p.hasSubscription(&observers[149], makeEvent<Event>(9)));
+}
+
+TYPED_TEST(IndexedPublisher, DenseIdsFastPath) {
+    using Event = TypeParam;
+    using PublisherType = culib::patterns::IndexedPublisher<Event, Value>;
+    PublisherType p;
+    CountingObserver<Event> o1, o2;
+
+    auto const e1 {p.addEvent(makeEvent<Event>(1))}, e2 {p.addEvent(makeEvent<Event>(2))};
+    ASSERT_EQ(p.addEvent(makeEvent<Event>(1)), e1);
+    ASSERT_EQ(p.eventId(makeEvent<Event>(2)), e2);
+    ASSERT_FALSE(p.eventId(makeEvent<Event>(3)).valid());
+
+    auto const id1 {p.Attach(&o1, niceValue, makeEvent<Event>(1))};
+    ASSERT_TRUE(id1.valid());
+    ASSERT_EQ(p.observerId(&o1), id1);
+    ASSERT_FALSE(p.Attach(&o2, niceValue, makeEvent<Event>(3)).valid());
+
+    ASSERT_TRUE(p.hasSubscription(id1, e1));
+    ASSERT_FALSE(p.hasSubscription(id1, e2));
+    ASSERT_FALSE(p.hasSubscription(typename PublisherType::ObserverId{}, e1));
+
+    p.pushUpdate(e1, 1.0);
+    p.pushUpdate(e2, 1.0);
+    p.pushUpdate(typename PublisherType::EventId{}, 1.0);
+    ASSERT_EQ(o1.calls, 1u);
+
+    p.removeEvent(makeEvent<Event>(1));
+    p.pushUpdate(e1, 1.0);
+    ASSERT_EQ(o1.calls, 1u);
+}
+
+TYPED_TEST(IndexedPublisher, ReAddedEventCanBeBooked) {
+    using Event = TypeParam;
+    culib::patterns::IndexedPublisher<Event, Value> p;
+    CountingObserver<Event> o;
+    Event const e {makeEvent<Event>(1)};
+
+    p.addEvent(e);
+    p.Attach(&o, niceValue, e);
+    p.removeEvent(e);
+    p.addEvent(e);
+    p.Attach(&o, niceValue, e);
+
+    ASSERT_TRUE(p.hasSubscription(&o, e));
+    ASSERT_EQ(p.getObservers(e).size(), 1u);
+    ASSERT_TRUE(p.mayHaveSubscribers(e));
+    p.pushUpdate(e, 1.0);
+    ASSERT_EQ(o.calls, 1u);
+}
+
+TYPED_TEST(IndexedPublisher, IndexRebuiltOnLoad) {
+    using Event = TypeParam;
+    using PublisherType = culib::patterns::IndexedPublisher<Event, Value>;
+    using ObserverType = typename PublisherType::ObserverType;
+    PublisherType saved, loaded;
+    CountingObserver<Event> o;
+    Event const e {makeEvent<Event>(1)};
+
+    saved.addEvent(e);
+    saved.Attach(&o, niceValue, e);
+    std::string const path {testing::TempDir() + "indexed_topology.bin"};
+    ASSERT_EQ(culib::patterns::saveTopology(path.c_str(), saved, [](ObserverType const*) { return std::uint64_t{7u}; }),
+              culib::patterns::SnapshotStatus::Ok);
+    ASSERT_EQ(culib::patterns::loadTopology(path.c_str(), loaded, [&o](std::uint64_t) -> ObserverType* { return &o; }),
+              culib::patterns::SnapshotStatus::Ok);
+    std::remove(path.c_str());
+
+    ASSERT_TRUE(loaded.hasSubscription(&o, e));
+    ASSERT_TRUE(loaded.mayHaveSubscribers(e));
+    loaded.pushUpdate(loaded.eventId(e), 1.0);
+    loaded.pushUpdate(e, 1.0);
+    ASSERT_EQ(o.calls, 2u);
+}
+
+TYPED_TEST(IndexedPublisher, BloomGrowsWithSubscribedEvents) {
+    using Event = TypeParam;
+    culib::patterns::IndexedPublisher<Event, Value> p {16u};
+    //Observer books its events in a flat list, so spread them
+    std::vector<CountingObserver<Event>> observers(100u);
+    int const subscribed {20'000};
+
+    for (int i = 0; i != 2 * subscribed; ++i) {
+        p.addEvent(makeEvent<Event>(i));
+    }
+    for (int i = 0; i != subscribed; ++i) {
+        p.Attach(&observers[static_cast<std::size_t>(i) % observers.size()], niceValue, makeEvent<Event>(i));
+    }
+    ASSERT_GE(p.bloomCounters(), static_cast<std::size_t>(subscribed) * p.countersPerEvent);
+
+    std::size_t falsePositives {0u};
+    for (int i = 0; i != subscribed; ++i) {
+        ASSERT_TRUE(p.mayHaveSubscribers(makeEvent<Event>(i)));
+        falsePositives += p.mayHaveSubscribers(makeEvent<Event>(subscribed + i)) ? 1u : 0u;
+    }
+    //about 1.4% expected at 16 counters per event
+    ASSERT_LT(falsePositives, static_cast<std::size_t>(subscribed) / 20u);
+
+    p.pushUpdate(makeEvent<Event>(subscribed - 1), 1.0);
+    ASSERT_EQ(observers[static_cast<std::size_t>(subscribed - 1) % observers.size()].calls, 1u);
+}
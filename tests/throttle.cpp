@@ -0,0 +1,197 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "include/throttle.hpp"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    using namespace std::chrono_literals;
+
+    using Event = std::string;
+    using Value = double;
+
+    struct ManualClock {
+        using duration = std::chrono::nanoseconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point<ManualClock>;
+        static constexpr bool is_steady {true};
+
+        static inline time_point current {};
+        static time_point now() noexcept { return current; }
+    };
+
+    struct RecordingObserver final : public culib::patterns::Observer<Event, Value> {
+        std::vector<Value> received;
+
+        void updateCallback(Event const&, Value const& value) & override {
+            received.push_back(value);
+        }
+    };
+
+    using ThrottledPublisher = culib::patterns::ThrottledPublisher<Event, Value, ManualClock>;
+    using culib::patterns::Throttle;
+
+    int const niceValue {10};
+
+    class ThrottledDelivery : public testing::Test {
+    protected:
+        void SetUp() override { ManualClock::current = ManualClock::time_point{1s}; }
+        static void sleep(std::chrono::nanoseconds d) { ManualClock::current += d; }
+    };
+
+}//!namespace
+
+
+TEST_F(ThrottledDelivery, MinIntervalLeadingAndTrailing) {
+    ThrottledPublisher p;
+    RecordingObserver o, plain;
+    p.addEvent("px");
+    p.Attach(&o, niceValue, Throttle::minInterval(10ms), Event{"px"});
+    p.Attach(&plain, niceValue, Event{"px"});
+    ASSERT_TRUE(p.hasSubscription(&o, "px"));
+    ASSERT_TRUE(p.hasSubscription(&plain, "px"));
+
+    p.pushUpdate("px", 1.0);
+    sleep(1ms);
+    p.pushUpdate("px", 2.0);
+    p.pushUpdate("px", 3.0);
+    ASSERT_EQ(o.received, std::vector<Value>{1.0});
+    ASSERT_EQ(plain.received.size(), 3u);
+
+    sleep(5ms);
+    ASSERT_EQ(p.advance(), 0u);
+    sleep(4ms);
+    ASSERT_EQ(p.advance(), 1u);
+    ASSERT_EQ(o.received, (std::vector<Value>{1.0, 3.0}));
+
+    sleep(20ms);
+    p.pushUpdate("px", 4.0);
+    ASSERT_EQ(o.received, (std::vector<Value>{1.0, 3.0, 4.0}));
+}
+
+TEST_F(ThrottledDelivery, MaxRateAllowsBurst) {
+    ThrottledPublisher p;
+    RecordingObserver o;
+    p.addEvent("px");
+    p.Attach(&o, niceValue, Throttle::maxRate(100.0, 3u), Event{"px"});
+
+    for (int i = 1; i <= 5; ++i) {
+        p.pushUpdate("px", i);
+    }
+    ASSERT_EQ(o.received, (std::vector<Value>{1.0, 2.0, 3.0}));
+
+    sleep(10ms);
+    p.advance();
+    ASSERT_EQ(o.received, (std::vector<Value>{1.0, 2.0, 3.0, 5.0}));
+}
+
+TEST(ThrottlePolicy, NonPositiveRateIsClamped) {
+    for (double const rate : {0.0, -1.0, std::numeric_limits<double>::quiet_NaN(), 1e-30}) {
+        Throttle const throttle {Throttle::maxRate(rate, 0u)};
+        ASSERT_EQ(throttle.interval, Throttle::maxInterval);
+        ASSERT_EQ(throttle.burst, 1u);
+    }
+    ASSERT_EQ(Throttle::maxRate(std::numeric_limits<double>::infinity()).interval.count(), 0);
+    ASSERT_EQ(Throttle::maxRate(1000.0).interval, std::chrono::milliseconds{1});
+}
+
+TEST_F(ThrottledDelivery, CoalesceLatestWins) {
+    ThrottledPublisher p;
+    RecordingObserver o;
+    p.addEvent("px");
+    p.Attach(&o, niceValue, Throttle::coalesce(5ms), Event{"px"});
+
+    p.pushUpdate("px", 1.0);
+    sleep(2ms);
+    p.pushUpdate("px", 2.0);
+    p.advance();
+    ASSERT_TRUE(o.received.empty());
+
+    sleep(3ms);
+    p.advance();
+    ASSERT_EQ(o.received, std::vector<Value>{2.0});
+
+    sleep(1s);
+    p.advance();
+    ASSERT_EQ(o.received.size(), 1u);
+}
+
+TEST_F(ThrottledDelivery, DetachDropsPending) {
+    ThrottledPublisher p;
+    RecordingObserver o;
+    p.addEvent("px");
+    p.Attach(&o, niceValue, Throttle::coalesce(5ms), Event{"px"});
+    p.pushUpdate("px", 1.0);
+
+    p.Detach(&o, Event{"px"});
+    ASSERT_FALSE(p.hasSubscription(&o, "px"));
+    ASSERT_TRUE(p.getObservers("px").empty());
+
+    sleep(10ms);
+    ASSERT_EQ(p.advance(), 0u);
+    ASSERT_TRUE(o.received.empty());
+}
+
+TEST_F(ThrottledDelivery, DueUpdateIsNotHeldByPending) {
+    ThrottledPublisher p;
+    RecordingObserver o;
+    p.addEvent("px");
+    p.Attach(&o, niceValue, Throttle::minInterval(10ms), Event{"px"});
+
+    p.pushUpdate("px", 1.0);
+    p.pushUpdate("px", 2.0);
+    //due, but nobody has driven the wheel yet
+    sleep(15ms);
+    p.pushUpdate("px", 3.0);
+    ASSERT_EQ(o.received, (std::vector<Value>{1.0, 3.0}));
+    sleep(15ms);
+    ASSERT_EQ(p.advance(), 0u);
+    ASSERT_EQ(o.received, (std::vector<Value>{1.0, 3.0}));
+}
+
+TEST_F(ThrottledDelivery, PlainAttachSeesThroughGate) {
+    ThrottledPublisher p;
+    RecordingObserver o;
+    p.addEvent("px");
+    p.Attach(&o, niceValue, Throttle::minInterval(10ms), Event{"px"});
+    p.Attach(&o, niceValue, Event{"px"});
+    p.Attach(&o, niceValue, std::vector<Event>{"px"});
+    ASSERT_EQ(p.getObservers("px").size(), 1u);
+
+    p.pushUpdate("px", 1.0);
+    ASSERT_EQ(o.received, std::vector<Value>{1.0});
+}
+
+TEST_F(ThrottledDelivery, RemovedEventTakesGatesAlong) {
+    ThrottledPublisher p;
+    RecordingObserver o;
+    p.addEvent("px");
+    p.Attach(&o, niceValue, Throttle::coalesce(5ms), Event{"px"});
+    p.pushUpdate("px", 1.0);
+
+    p.removeEvent("px");
+    ASSERT_FALSE(p.hasSubscription(&o, "px"));
+    sleep(10ms);
+    ASSERT_EQ(p.advance(), 0u);
+    ASSERT_TRUE(o.received.empty());
+
+    p.addEvent("px");
+    ASSERT_FALSE(p.hasSubscription(&o, "px"));
+    p.Attach(&o, niceValue, Throttle::minInterval(10ms), Event{"px"});
+    ASSERT_TRUE(p.hasSubscription(&o, "px"));
+    ASSERT_EQ(p.getObservers("px").size(), 1u);
+    p.pushUpdate("px", 2.0);
+    ASSERT_EQ(o.received, std::vector<Value>{2.0});
+
+    p.Detach(&o, Event{"px"});
+    ASSERT_FALSE(p.hasSubscription(&o, "px"));
+    ASSERT_TRUE(p.getObservers("px").empty());
+}
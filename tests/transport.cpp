@@ -0,0 +1,240 @@
+//
+// Created by Andrey Solovyev on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "include/transport.hpp"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+    using Value = double;
+
+    template <typename Event>
+    struct RecordingObserver final : public culib::patterns::Observer<Event, Value> {
+        std::vector<std::pair<Event, Value>> received;
+
+        void updateCallback(Event const& event, Value const& value) & override {
+            received.emplace_back(event, value);
+        }
+    };
+
+    int const niceValue {10};
+
+    struct Instrument {
+        std::int32_t venue;
+        std::int32_t id;
+        bool operator==(Instrument const&) const = default;
+    };
+
+    struct Padded {
+        char tag;
+        double price;
+    };
+
+    template<typename T>
+    concept HasSnapshotCodec = requires(std::string& out, T const& value) {
+        culib::patterns::SnapshotCodec<T>::write(out, value);
+    };
+
+}//!namespace
+
+template<>
+inline constexpr bool culib::patterns::enable_raw_codec_v<Instrument> {true};
+
+
+TEST(LocalTransport, BatchedFramesOverUnixPath) {
+    using Event = std::string;
+    std::string const path {testing::TempDir() + "pb_transport.sock"};
+    auto listener {culib::patterns::LocalSocket::listen(path)};
+    ASSERT_TRUE(listener.valid());
+
+    auto client {culib::patterns::LocalSocket::connect(path)};
+    ASSERT_TRUE(client.valid());
+    auto server {listener.accept()};
+    ASSERT_TRUE(server.valid());
+
+    culib::patterns::Publisher<Event, Value> p;
+    culib::patterns::RemoteObserver<Event, Value> remote {std::move(server), 1024u};
+    p.addEvent("px");
+    p.Attach(&remote, niceValue, Event{"px"});
+
+    RecordingObserver<Event> local;
+    culib::patterns::RemoteObserverAdapter<Event, Value> adapter {std::move(client), &local};
+
+    std::size_t const updates {500u};
+    std::thread consumer([&adapter, &local, updates] {
+        while (local.received.size() < updates && adapter.connected()) {
+            adapter.receive();
+        }
+    });
+    for (std::size_t i = 0; i != updates; ++i) {
+        p.pushUpdate("px", static_cast<Value>(i));
+    }
+    remote.flush();
+    consumer.join();
+    ::unlink(path.c_str());
+
+    ASSERT_FALSE(remote.broken());
+    ASSERT_FALSE(adapter.malformed());
+    ASSERT_EQ(local.received.size(), updates);
+    for (std::size_t i = 0; i != updates; ++i) {
+        ASSERT_EQ(local.received[i], std::pair(Event{"px"}, static_cast<Value>(i)));
+    }
+}
+
+TEST(LocalTransport, ZeroCopyImmediateFrames) {
+    using Event = int;
+    auto [server, client] {culib::patterns::LocalSocket::pair()};
+    ASSERT_TRUE(server.valid() && client.valid());
+
+    culib::patterns::Publisher<Event, Value> p;
+    culib::patterns::RemoteObserver<Event, Value> remote {std::move(server), 0u};
+    p.addEvent(7);
+    p.Attach(&remote, niceValue, 7);
+
+    RecordingObserver<Event> local;
+    culib::patterns::RemoteObserverAdapter<Event, Value> adapter {std::move(client), &local};
+
+    p.pushUpdate(7, 1.5);
+    p.pushUpdate(7, 2.5);
+    while (local.received.size() < 2u) {
+        adapter.receive();
+    }
+    ASSERT_EQ(local.received[0], std::pair(7, 1.5));
+    ASSERT_EQ(local.received[1], std::pair(7, 2.5));
+    ASSERT_EQ(adapter.receive(false), 0u);
+    ASSERT_TRUE(adapter.connected());
+}
+
+TEST(LocalTransport, RawBytesOnlyForOptedInTypes) {
+    static_assert(HasSnapshotCodec<double> && HasSnapshotCodec<std::string>);
+    static_assert(!HasSnapshotCodec<Padded> && !HasSnapshotCodec<int*> && !HasSnapshotCodec<long double>);
+    static_assert(HasSnapshotCodec<Instrument>);
+
+    using Event = Instrument;
+    auto [server, client] {culib::patterns::LocalSocket::pair()};
+    ASSERT_TRUE(server.valid() && client.valid());
+    culib::patterns::RemoteObserver<Event, Value> remote {std::move(server), 0u};
+    RecordingObserver<Event> local;
+    culib::patterns::RemoteObserverAdapter<Event, Value> adapter {std::move(client), &local};
+
+    remote.updateCallback(Instrument{3, 42}, 1.5);
+    while (local.received.empty()) {
+        adapter.receive();
+    }
+    ASSERT_EQ(local.received[0], std::pair(Instrument{3, 42}, 1.5));
+}
+
+TEST(LocalTransport, DisconnectAndMalformedFrame) {
+    using Event = int;
+    RecordingObserver<Event> local;
+    {
+        auto [server, client] {culib::patterns::LocalSocket::pair()};
+        culib::patterns::RemoteObserverAdapter<Event, Value> adapter {std::move(client), &local};
+        server.close();
+        ASSERT_EQ(adapter.receive(), 0u);
+        ASSERT_FALSE(adapter.connected());
+    }
+    {
+        auto [server, client] {culib::patterns::LocalSocket::pair()};
+        culib::patterns::RemoteObserverAdapter<Event, Value> adapter {std::move(client), &local};
+        std::uint32_t const size {3u};
+        char bytes[sizeof(size) + size] {};
+        std::memcpy(bytes, &size, sizeof(size));
+        ASSERT_EQ(::send(server.fd(), bytes, sizeof(bytes), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(bytes)));
+        ASSERT_EQ(adapter.receive(), 0u);
+        ASSERT_TRUE(adapter.malformed());
+        ASSERT_FALSE(adapter.connected());
+    }
+    ASSERT_TRUE(local.received.empty());
+}
+
+TEST(LocalTransport, OversizedLengthsRejected) {
+    using Event = std::string;
+    RecordingObserver<Event> local;
+    {
+        //string length far beyond the frame must not be allocated
+        auto [server, client] {culib::patterns::LocalSocket::pair()};
+        culib::patterns::RemoteObserverAdapter<Event, Value> adapter {std::move(client), &local};
+        std::uint32_t const size {12u}, length {0xFFFFFFF0u};
+        char bytes[sizeof(size) + size] {};
+        std::memcpy(bytes, &size, sizeof(size));
+        std::memcpy(bytes + sizeof(size), &length, sizeof(length));
+        ASSERT_EQ(::send(server.fd(), bytes, sizeof(bytes), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(bytes)));
+        ASSERT_EQ(adapter.receive(), 0u);
+        ASSERT_TRUE(adapter.malformed());
+    }
+    {
+        //frame above the limit is rejected by its header, before it is buffered
+        auto [server, client] {culib::patterns::LocalSocket::pair()};
+        culib::patterns::RemoteObserverAdapter<Event, Value> adapter {std::move(client), &local, 64u * 1024u, 256u};
+        std::uint32_t const size {257u};
+        ASSERT_EQ(::send(server.fd(), &size, sizeof(size), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(size)));
+        ASSERT_EQ(adapter.receive(), 0u);
+        ASSERT_TRUE(adapter.malformed());
+        ASSERT_FALSE(adapter.connected());
+    }
+    ASSERT_TRUE(local.received.empty());
+}
+
+TEST(LocalTransport, SlowConsumerDoesNotBlockPublisher) {
+    using Event = int;
+    auto [server, client] {culib::patterns::LocalSocket::pair()};
+    ASSERT_TRUE(server.valid() && client.valid());
+
+    culib::patterns::Publisher<Event, Value> p;
+    culib::patterns::RemoteObserver<Event, Value> remote {std::move(server), 0u, 16u * 1024u * 1024u};
+    p.addEvent(7);
+    p.Attach(&remote, niceValue, 7);
+
+    //nobody reads yet, far more than a socket buffer takes goes to the backlog
+    std::size_t const updates {100'000u};
+    for (std::size_t i = 0; i != updates; ++i) {
+        p.pushUpdate(7, static_cast<Value>(i));
+    }
+    ASSERT_FALSE(remote.broken());
+    ASSERT_NE(remote.pending(), 0u);
+
+    RecordingObserver<Event> local;
+    culib::patterns::RemoteObserverAdapter<Event, Value> adapter {std::move(client), &local};
+    while (local.received.size() < updates && adapter.connected()) {
+        adapter.receive(false);
+        remote.flush();
+    }
+    ASSERT_EQ(remote.pending(), 0u);
+    ASSERT_EQ(local.received.size(), updates);
+    for (std::size_t i = 0; i != updates; ++i) {
+        ASSERT_EQ(local.received[i].second, static_cast<Value>(i));
+    }
+}
+
+TEST(LocalTransport, StalledConsumerIsDisconnected) {
+    using Event = int;
+    auto [server, client] {culib::patterns::LocalSocket::pair()};
+
+    culib::patterns::Publisher<Event, Value> p;
+    culib::patterns::RemoteObserver<Event, Value> remote {std::move(server), 1024u, 64u * 1024u};
+    p.addEvent(7);
+    p.Attach(&remote, niceValue, 7);
+
+    for (std::size_t i = 0; i != 1'000'000u && !remote.broken(); ++i) {
+        p.pushUpdate(7, static_cast<Value>(i));
+    }
+    ASSERT_TRUE(remote.broken());
+    ASSERT_EQ(remote.pending(), 0u);
+
+    //consumer gets what was in the socket before the cut, then the end of stream
+    RecordingObserver<Event> local;
+    culib::patterns::RemoteObserverAdapter<Event, Value> adapter {std::move(client), &local};
+    while (adapter.connected()) {
+        adapter.receive();
+    }
+    ASSERT_FALSE(adapter.malformed());
+    ASSERT_FALSE(local.received.empty());
+}